@@ -0,0 +1,687 @@
+/**
+ * HYDRA-SORT Engine Benchmark
+ *
+ * Single-core A/B comparisons between individual engines and variants.
+ * Runs on the RP2040 and on hosts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hydra_sort_v2.h"
+
+// Number of iterations for averaging
+#define ITERATIONS 5
+
+#if HYDRA_PLATFORM_PICO
+#define MAX_SIZE 10000
+#else
+#define MAX_SIZE 1000000
+#endif
+
+// Buffers
+static int32_t data_original[MAX_SIZE];
+static int32_t data_work[MAX_SIZE];
+
+// ─── Input generators ───────────────────────────────────────────────────────
+
+static void fill_random(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() - RAND_MAX / 2;
+}
+
+static void fill_few_unique(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() % 16;
+}
+
+// Eight widely spaced keys: low cardinality the radix path cannot take
+static void fill_low_cardinality(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (rand() % 8) * 250000000 - 1000000000;
+}
+
+static void fill_sorted(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)i;
+}
+
+// Sorted streams of random keys, concatenated
+static size_t stream_count = 32;
+
+static void fill_streams(int32_t* arr, size_t n) {
+    size_t len = (n + stream_count - 1) / stream_count;
+    for (size_t i = 0; i < n; i++) arr[i] = rand() - RAND_MAX / 2;
+    for (size_t i = 0; i < n; i += len) {
+        hydra_introsort(arr + i, (n - i < len) ? n - i : len);
+    }
+}
+
+// Sorted, then 1% of neighbours swapped (inversions stay local)
+static void fill_local_swaps(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)i;
+    for (size_t k = 0; k < n / 100; k++) {
+        size_t i = (size_t)rand() % (n - 1);
+        int32_t t = arr[i]; arr[i] = arr[i + 1]; arr[i + 1] = t;
+    }
+}
+
+// Sorted, then 1% of keys replaced at random (same presort score, but
+// each stray key is far from its place)
+static void fill_scattered(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)i;
+    for (size_t k = 0; k < n / 100; k++) arr[(size_t)rand() % n] = rand() % (int32_t)n;
+}
+
+// Non-negative keys below 2^16 / 2^22 (range-limited sensor data)
+static void fill_range16(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() & 0xFFFF;
+}
+
+static void fill_range22(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() & 0x3FFFFF;
+}
+
+// 12-bit ADC samples, and ranges sized against n
+static void fill_adc12(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() & 0xFFF;
+}
+
+static void fill_range_quarter_n(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() % (int32_t)(n / 4) - (int32_t)(n / 8);
+}
+
+static void fill_range_n(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() % (int32_t)n - (int32_t)(n / 2);
+}
+
+static void fill_range_4n(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)(((uint32_t)rand() << 8 ^ (uint32_t)rand()) % (4 * n));
+}
+
+// Full 32-bit signed range
+static void fill_full32(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+}
+
+// ─── Harness ────────────────────────────────────────────────────────────────
+
+typedef void (*SortFn)(int32_t* arr, size_t n);
+
+static bool verify_sorted(const int32_t* arr, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (arr[i] < arr[i-1]) return false;
+    }
+    return true;
+}
+
+// Average microseconds for sort_fn over ITERATIONS fresh inputs
+static float time_sort(SortFn sort_fn, size_t n, void (*fill_func)(int32_t*, size_t), bool* ok) {
+    uint64_t total = 0;
+    for (int iter = 0; iter < ITERATIONS; iter++) {
+        fill_func(data_original, n);
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        uint64_t start = hydra_clock_us();
+        sort_fn(data_work, n);
+        total += hydra_clock_us() - start;
+        if (!verify_sorted(data_work, n)) *ok = false;
+    }
+    return (float)total / ITERATIONS;
+}
+
+static void print_header(const char* title, const char* a, const char* b) {
+    printf("%s\n", title);
+    printf("┌──────────────┬─────────┬────────────┬────────────┬────────┬──────┐\n");
+    printf("│ Input        │ Size    │ %10s │ %10s │ B vs A │ Check│\n", a, b);
+    printf("├──────────────┼─────────┼────────────┼────────────┼────────┼──────┤\n");
+}
+
+static void print_footer(void) {
+    printf("└──────────────┴─────────┴────────────┴────────────┴────────┴──────┘\n\n");
+}
+
+static void compare(const char* name, size_t n, void (*fill_func)(int32_t*, size_t),
+                    SortFn a, SortFn b) {
+    bool ok = true;
+    float ta = time_sort(a, n, fill_func, &ok);
+    float tb = time_sort(b, n, fill_func, &ok);
+    printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+           name, n, ta, tb, ta / tb, ok ? " OK " : "FAIL");
+}
+
+// ─── Partition schemes ──────────────────────────────────────────────────────
+
+static void introsort_lomuto(int32_t* arr, size_t n) {
+    hydra_set_partition_scheme(HYDRA_PARTITION_LOMUTO);
+    hydra_introsort(arr, n);
+}
+
+static void introsort_block(int32_t* arr, size_t n) {
+    hydra_set_partition_scheme(HYDRA_PARTITION_BLOCK);
+    hydra_introsort(arr, n);
+}
+
+static void bench_partition(void) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+
+    print_header("PARTITION SCHEMES (introsort, µs)", "Lomuto", "Block");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Random", sizes[i], fill_random, introsort_lomuto, introsort_block);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("FewUnique", sizes[i], fill_few_unique, introsort_lomuto, introsort_block);
+    }
+    print_footer();
+}
+
+// ─── Dual-pivot vs single-pivot ─────────────────────────────────────────────
+
+static void bench_dual_pivot_against(const char* title, const char* name, SortFn introsort_fn) {
+    static const size_t sizes[] = {100, 300, 1000, 3000, 10000, 100000, 1000000};
+
+    print_header(title, name, "DualPivot");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Random", sizes[i], fill_random, introsort_fn, hydra_dual_pivot_sort);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("FewUnique", sizes[i], fill_few_unique, introsort_fn, hydra_dual_pivot_sort);
+    }
+    print_footer();
+}
+
+// Introsort with the platform's default partition scheme
+static void introsort_default(int32_t* arr, size_t n) {
+#if HYDRA_PLATFORM_PICO
+    hydra_set_partition_scheme(HYDRA_PARTITION_LOMUTO);
+#else
+    hydra_set_partition_scheme(HYDRA_PARTITION_BLOCK);
+#endif
+    hydra_introsort(arr, n);
+}
+
+static void bench_dual_pivot(void) {
+    bench_dual_pivot_against("DUAL-PIVOT vs LOMUTO INTROSORT (µs)", "Lomuto", introsort_lomuto);
+    bench_dual_pivot_against("DUAL-PIVOT vs BLOCK INTROSORT (µs)", "Block", introsort_block);
+}
+
+// ─── Pattern-defeating quicksort ────────────────────────────────────────────
+
+static void bench_pdqsort(void) {
+    static const size_t sizes[] = {1000, 4096, 100000, 1000000};
+    static const struct {
+        const char* name;
+        void (*fill)(int32_t*, size_t);
+    } inputs[] = {
+        {"Random", fill_random},
+        {"FewUnique", fill_few_unique},
+        {"LowCard", fill_low_cardinality},
+        {"Sorted", fill_sorted},
+    };
+
+    print_header("PDQSORT vs INTROSORT (default partition, µs)", "Introsort", "Pdqsort");
+    for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            if (sizes[i] > MAX_SIZE) break;
+            compare(inputs[k].name, sizes[i], inputs[k].fill, introsort_default, hydra_pdqsort);
+        }
+    }
+    print_footer();
+}
+
+// ─── Natural-run merge sort ─────────────────────────────────────────────────
+
+static int32_t aux_work[MAX_SIZE];
+
+static void powersort(int32_t* arr, size_t n) {
+    hydra_powersort(arr, n, aux_work);
+}
+
+static void bench_powersort(void) {
+    static const size_t sizes[] = {4096, 100000, 1000000};
+    static const size_t streams[] = {4, 32, 256};
+    char name[16];
+
+    print_header("POWERSORT vs PDQSORT (sorted streams, µs)", "Pdqsort", "Powersort");
+    for (size_t k = 0; k < sizeof(streams) / sizeof(streams[0]); k++) {
+        stream_count = streams[k];
+        snprintf(name, sizeof(name), "Streams x%zu", streams[k]);
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            if (sizes[i] > MAX_SIZE) break;
+            compare(name, sizes[i], fill_streams, hydra_pdqsort, powersort);
+        }
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Random", sizes[i], fill_random, hydra_pdqsort, powersort);
+    }
+    print_footer();
+
+    static const size_t nearly_sizes[] = {1000, 2048, 10000, 100000};
+    print_header("NEARLY SORTED: INSERTION vs POWERSORT (µs)", "Insertion", "Powersort");
+    for (size_t i = 0; i < sizeof(nearly_sizes) / sizeof(nearly_sizes[0]); i++) {
+        if (nearly_sizes[i] > MAX_SIZE) break;
+        compare("LocalSwaps", nearly_sizes[i], fill_local_swaps, hydra_insertion_sentinel, powersort);
+    }
+    for (size_t i = 0; i < sizeof(nearly_sizes) / sizeof(nearly_sizes[0]); i++) {
+        if (nearly_sizes[i] > MAX_SIZE) break;
+        compare("Scattered", nearly_sizes[i], fill_scattered, hydra_insertion_sentinel, powersort);
+    }
+    print_footer();
+}
+
+// ─── Stable profile ─────────────────────────────────────────────────────────
+
+static void balanced_aux(int32_t* arr, size_t n)  { hydra_sort(arr, n, aux_work, HYDRA_PROFILE_BALANCED); }
+static void stable_aux(int32_t* arr, size_t n)    { hydra_sort(arr, n, aux_work, HYDRA_PROFILE_STABLE); }
+static void balanced_noaux(int32_t* arr, size_t n) { hydra_sort(arr, n, NULL, HYDRA_PROFILE_BALANCED); }
+static void stable_noaux(int32_t* arr, size_t n)   { hydra_sort(arr, n, NULL, HYDRA_PROFILE_STABLE); }
+
+// What restricting selection to stable engines costs
+static void bench_stable(void) {
+    static const size_t sizes[] = {1000, 100000, 1000000};
+    static const struct { const char* name; void (*fill)(int32_t*, size_t); } inputs[] = {
+        {"Random", fill_full32}, {"Streams", fill_streams}, {"LocalSwaps", fill_local_swaps},
+        {"Range16", fill_range16}, {"FewUnique", fill_few_unique},
+    };
+    stream_count = 32;
+
+    for (int with_aux = 1; with_aux >= 0; with_aux--) {
+        print_header(with_aux ? "BALANCED vs STABLE PROFILE, aux n (µs)"
+                              : "BALANCED vs STABLE PROFILE, no aux (µs)",
+                     "Balanced", "Stable");
+        for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+            for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+                if (sizes[i] > MAX_SIZE) break;
+                compare(inputs[k].name, sizes[i], inputs[k].fill,
+                        with_aux ? balanced_aux : balanced_noaux,
+                        with_aux ? stable_aux : stable_noaux);
+            }
+        }
+        print_footer();
+    }
+}
+
+// ─── Range-compressed radix ─────────────────────────────────────────────────
+
+static void radix_256(int32_t* arr, size_t n) {
+    hydra_radix_sort_256((uint32_t*)arr, (uint32_t*)aux_work, n);
+}
+
+// Includes the analysis pass that supplies min_val and range_log2
+static void radix_i32(int32_t* arr, size_t n) {
+    HydraFeatures f = hydra_analyze(arr, n);
+    hydra_radix_sort_i32(arr, aux_work, n, f.min_val, f.range_log2);
+}
+
+static void bench_radix(void) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+    static const struct {
+        const char* name;
+        void (*fill)(int32_t*, size_t);
+    } inputs[] = {
+        {"Range 2^16", fill_range16},
+        {"Range 2^22", fill_range22},
+    };
+
+    // Non-negative only: radix_256 misorders negative keys
+    print_header("RADIX: 4 BYTE PASSES vs RANGE-COMPRESSED (µs)", "Radix256", "RadixI32");
+    for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            if (sizes[i] > MAX_SIZE) break;
+            compare(inputs[k].name, sizes[i], inputs[k].fill, radix_256, radix_i32);
+        }
+    }
+    print_footer();
+
+    print_header("RADIX vs PDQSORT (µs)", "Pdqsort", "RadixI32");
+    for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            if (sizes[i] > MAX_SIZE) break;
+            compare(inputs[k].name, sizes[i], inputs[k].fill, hydra_pdqsort, radix_i32);
+        }
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Full 32-bit", sizes[i], fill_full32, hydra_pdqsort, radix_i32);
+    }
+    print_footer();
+}
+
+// ─── Int32 counting sort ────────────────────────────────────────────────────
+
+static uint32_t* count_hist;
+
+// Histogram outside the timed region's allocations, like aux for radix
+static void counting_i32(int32_t* arr, size_t n) {
+    HydraFeatures f = hydra_analyze(arr, n);
+    hydra_counting_sort_i32(arr, n, f.min_val, f.max_val, count_hist);
+}
+
+static void bench_counting(void) {
+    static const size_t sizes[] = {1000, 5000, 100000, 1000000};
+    static const struct {
+        const char* name;
+        void (*fill)(int32_t*, size_t);
+    } inputs[] = {
+        {"ADC 12-bit", fill_adc12},
+        {"Range n/4", fill_range_quarter_n},
+        {"Range n", fill_range_n},
+        {"Range 4n", fill_range_4n},
+    };
+    count_hist = (uint32_t*)malloc((4 * MAX_SIZE + 4096) * sizeof(uint32_t));
+    if (!count_hist) {
+        printf("COUNTING: skipped, cannot allocate the histogram\n\n");
+        return;
+    }
+
+    print_header("RADIX vs INT32 COUNTING SORT (µs)", "RadixI32", "Counting");
+    for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            if (sizes[i] > MAX_SIZE) break;
+            compare(inputs[k].name, sizes[i], inputs[k].fill, radix_i32, counting_i32);
+        }
+    }
+    print_footer();
+    free(count_hist);
+}
+
+// ─── In-place MSD radix ─────────────────────────────────────────────────────
+
+static void american_flag(int32_t* arr, size_t n) {
+    HydraFeatures f = hydra_analyze(arr, n);
+    hydra_american_flag_sort(arr, n, f.min_val, f.range_log2);
+}
+
+static void bench_american_flag(void) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+
+    print_header("RADIX: LSD WITH AUX vs IN-PLACE AMERICAN FLAG (µs)", "RadixI32", "AmFlag");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Range 2^16", sizes[i], fill_range16, radix_i32, american_flag);
+        compare("Range 2^22", sizes[i], fill_range22, radix_i32, american_flag);
+        compare("Full 32-bit", sizes[i], fill_full32, radix_i32, american_flag);
+    }
+    print_footer();
+
+    print_header("IN PLACE: PDQSORT vs AMERICAN FLAG (µs)", "Pdqsort", "AmFlag");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (sizes[i] > MAX_SIZE) break;
+        compare("Range 2^16", sizes[i], fill_range16, hydra_pdqsort, american_flag);
+        compare("Full 32-bit", sizes[i], fill_full32, hydra_pdqsort, american_flag);
+    }
+    print_footer();
+}
+
+// ─── Batched small arrays ───────────────────────────────────────────────────
+
+static size_t batch_len;
+
+static void per_array_sort(int32_t* arr, size_t n) {
+    for (size_t i = 0; i + batch_len <= n; i += batch_len) {
+        hydra_sort(arr + i, batch_len, NULL, HYDRA_PROFILE_BALANCED);
+    }
+}
+
+static void batch_sort(int32_t* arr, size_t n) {
+    hydra_sort_batch_strided(arr, batch_len, batch_len, n / batch_len);
+}
+
+static bool verify_batches(const int32_t* arr, size_t n) {
+    for (size_t i = 0; i + batch_len <= n; i += batch_len) {
+        if (!verify_sorted(arr + i, batch_len)) return false;
+    }
+    return true;
+}
+
+static void bench_batch(void) {
+    static const size_t lens[] = {5, 8, 12, 16, 24, 32, 48, 64};
+    size_t n = (MAX_SIZE < 100000) ? MAX_SIZE : 100000;
+
+    // One worker: this compares dispatch and networks, not cores
+    hydra_set_workers(1);
+    print_header("BATCH: hydra_sort PER ARRAY vs hydra_sort_batch (µs)", "PerArray", "Batch");
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        char name[16];
+        uint64_t ta = 0, tb = 0;
+        bool ok = true;
+        batch_len = lens[i];
+        size_t total = n - n % batch_len;
+        for (int iter = 0; iter < ITERATIONS; iter++) {
+            fill_random(data_original, total);
+            memcpy(data_work, data_original, total * sizeof(int32_t));
+            uint64_t start = hydra_clock_us();
+            per_array_sort(data_work, total);
+            ta += hydra_clock_us() - start;
+            if (!verify_batches(data_work, total)) ok = false;
+            memcpy(data_work, data_original, total * sizeof(int32_t));
+            start = hydra_clock_us();
+            batch_sort(data_work, total);
+            tb += hydra_clock_us() - start;
+            if (!verify_batches(data_work, total)) ok = false;
+        }
+        snprintf(name, sizeof(name), "Len %zu", batch_len);
+        printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+               name, total, (float)ta / ITERATIONS, (float)tb / ITERATIONS,
+               (float)ta / (float)tb, ok ? " OK " : "FAIL");
+    }
+    print_footer();
+    hydra_set_workers(0);
+}
+
+// ─── Selection ──────────────────────────────────────────────────────────────
+
+// Full sort vs median, top 100 and three percentiles; checked against the sort
+static void bench_select(void) {
+    static const size_t sizes[] = {1000, 65536, 1000000};
+    static const char* ops[] = {"Median", "Top 100", "p50/99/999"};
+    hydra_set_workers(1);
+
+    print_header("SELECT: hydra_sort vs nth_element / partial_sort (µs)", "Sort", "Select");
+    for (int op = 0; op < 3; op++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            size_t n = sizes[i];
+            if (n > MAX_SIZE) break;
+            size_t ranks[3] = {n / 2, n * 99 / 100, n * 999 / 1000};
+            uint64_t ta = 0, tb = 0;
+            bool ok = true;
+            for (int iter = 0; iter < ITERATIONS; iter++) {
+                fill_full32(data_original, n);
+                memcpy(data_work, data_original, n * sizeof(int32_t));
+                uint64_t start = hydra_clock_us();
+                hydra_sort(data_work, n, aux_work, HYDRA_PROFILE_BALANCED);
+                ta += hydra_clock_us() - start;
+                int32_t* sorted = aux_work;
+                memcpy(sorted, data_work, n * sizeof(int32_t));
+                
+                memcpy(data_work, data_original, n * sizeof(int32_t));
+                start = hydra_clock_us();
+                if (op == 0) hydra_nth_element(data_work, n, n / 2, NULL);
+                else if (op == 1) hydra_partial_sort(data_work, n, 100, NULL);
+                else hydra_nth_elements(data_work, n, ranks, 3, NULL);
+                tb += hydra_clock_us() - start;
+                
+                if (op == 1) {
+                    ok = ok && memcmp(data_work, sorted, 100 * sizeof(int32_t)) == 0;
+                } else {
+                    for (int r = 0; r < (op == 0 ? 1 : 3); r++) {
+                        ok = ok && data_work[ranks[r]] == sorted[ranks[r]];
+                    }
+                }
+            }
+            printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+                   ops[op], n, (float)ta / ITERATIONS, (float)tb / ITERATIONS,
+                   (float)ta / (float)tb, ok ? " OK " : "FAIL");
+        }
+    }
+    print_footer();
+    hydra_set_workers(0);
+}
+
+// Microsecond latencies: a dense body and a 1% tail out to 250 ms
+static void fill_latency(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        arr[i] = 200 + rand() % 800 + ((rand() % 100 == 0) ? rand() % 250000 : 0);
+    }
+}
+
+static void bench_quantiles(void) {
+    static const size_t sizes[] = {1000, 65536, 1000000};
+    static const char* names[] = {"Full 32-bit", "Latency µs"};
+    static void (*const fills[])(int32_t*, size_t) = {fill_full32, fill_latency};
+    hydra_set_workers(1);
+
+    print_header("QUANTILES p50/99/999: copy + nth_elements vs read-only (µs)", "Select", "Quantile");
+    for (int d = 0; d < 2; d++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            size_t n = sizes[i];
+            if (n > MAX_SIZE) break;
+            size_t ranks[3] = {hydra_quantile_rank(n, 500000), hydra_quantile_rank(n, 990000),
+                               hydra_quantile_rank(n, 999000)};
+            uint64_t ta = 0, tb = 0;
+            bool ok = true;
+            for (int iter = 0; iter < ITERATIONS; iter++) {
+                fills[d](data_original, n);
+                uint64_t start = hydra_clock_us();
+                memcpy(data_work, data_original, n * sizeof(int32_t));
+                hydra_nth_elements(data_work, n, ranks, 3, NULL);
+                ta += hydra_clock_us() - start;
+                
+                int32_t q[3] = {0};
+                start = hydra_clock_us();
+                hydra_quantiles(data_original, n, ranks, 3, q);
+                tb += hydra_clock_us() - start;
+                for (int r = 0; r < 3; r++) ok = ok && q[r] == data_work[ranks[r]];
+            }
+            printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+                   names[d], n, (float)ta / ITERATIONS, (float)tb / ITERATIONS,
+                   (float)ta / (float)tb, ok ? " OK " : "FAIL");
+        }
+    }
+    print_footer();
+    hydra_set_workers(0);
+}
+
+// ─── Write-combining radix scatter ──────────────────────────────────────────
+
+#if HYDRA_RADIX_WC
+#ifndef BENCH_SCATTER_MAX
+#define BENCH_SCATTER_MAX 100000000
+#endif
+
+static int32_t* scatter_aux;
+
+static void radix_256_wc_on(int32_t* arr, size_t n, size_t threshold) {
+    hydra_set_radix_wc_threshold(threshold);
+    hydra_radix_sort_256((uint32_t*)arr, (uint32_t*)scatter_aux, n);
+}
+
+static void radix_i32_wc_on(int32_t* arr, size_t n, size_t threshold) {
+    hydra_set_radix_wc_threshold(threshold);
+    HydraFeatures f = hydra_analyze(arr, n);
+    hydra_radix_sort_i32(arr, scatter_aux, n, f.min_val, f.range_log2);
+}
+
+static void radix_256_big_plain(int32_t* arr, size_t n) { radix_256_wc_on(arr, n, SIZE_MAX); }
+static void radix_256_big_wc(int32_t* arr, size_t n)    { radix_256_wc_on(arr, n, 0); }
+static void radix_i32_big_plain(int32_t* arr, size_t n) { radix_i32_wc_on(arr, n, SIZE_MAX); }
+static void radix_i32_big_wc(int32_t* arr, size_t n)    { radix_i32_wc_on(arr, n, 0); }
+
+// Best of a few runs on heap buffers (10^8 elements do not fit the static ones)
+static float time_large(SortFn sort_fn, const int32_t* input, int32_t* work, size_t n, bool* ok) {
+    int runs = (n >= 10000000) ? 2 : 5;
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < runs; r++) {
+        memcpy(work, input, n * sizeof(int32_t));
+        uint64_t start = hydra_clock_us();
+        sort_fn(work, n);
+        uint64_t t = hydra_clock_us() - start;
+        if (t < best) best = t;
+        if (!verify_sorted(work, n)) *ok = false;
+    }
+    return (float)best;
+}
+
+static void bench_scatter_pair(const char* name, SortFn plain, SortFn wc,
+                               const int32_t* input, int32_t* work, size_t n) {
+    bool ok = true;
+    float ta = time_large(plain, input, work, n, &ok);
+    float tb = time_large(wc, input, work, n, &ok);
+    printf("│ %-12s │ %9zu │ %10.0f │ %10.0f │ %5.2fx │ %s │\n",
+           name, n, ta, tb, ta / tb, ok ? " OK " : "FAIL");
+}
+
+static void bench_scatter(void) {
+    static const size_t sizes[] = {
+        10000, 30000, 100000, 300000, 1000000, 3000000, 10000000, 30000000, 100000000
+    };
+    size_t max_n = BENCH_SCATTER_MAX;
+    int32_t* input = (int32_t*)malloc(max_n * sizeof(int32_t));
+    int32_t* work = (int32_t*)malloc(max_n * sizeof(int32_t));
+    int32_t* aux = (int32_t*)malloc(max_n * sizeof(int32_t));
+    if (!input || !work || !aux) {
+        printf("RADIX SCATTER: skipped, cannot allocate %zu elements\n\n", max_n);
+        free(input); free(work); free(aux);
+        return;
+    }
+
+    printf("RADIX SCATTER: PLAIN vs WRITE-COMBINING (best of runs, µs)\n");
+    printf("┌──────────────┬───────────┬────────────┬────────────┬────────┬──────┐\n");
+    printf("│ Input        │ Size      │      Plain │   Combined │ B vs A │ Check│\n");
+    printf("├──────────────┼───────────┼────────────┼────────────┼────────┼──────┤\n");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && sizes[i] <= max_n; i++) {
+        size_t n = sizes[i];
+        // 31-bit keys: radix_256 treats the sign bit as the top key bit
+        fill_full32(input, n);
+        for (size_t k = 0; k < n; k++) input[k] &= INT32_MAX;
+        scatter_aux = aux;
+        bench_scatter_pair("Radix256", radix_256_big_plain, radix_256_big_wc, input, work, n);
+        bench_scatter_pair("RadixI32", radix_i32_big_plain, radix_i32_big_wc, input, work, n);
+    }
+    printf("└──────────────┴───────────┴────────────┴────────────┴────────┴──────┘\n\n");
+    hydra_set_radix_wc_threshold(HYDRA_RADIX_WC_THRESHOLD);
+
+    free(input);
+    free(work);
+    free(aux);
+}
+#endif
+
+int main() {
+#if HYDRA_PLATFORM_PICO
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    printf("\n");
+    printf("╔═══════════════════════════════════════════════════════════════════╗\n");
+    printf("║                 HYDRA-SORT ENGINE BENCHMARK                       ║\n");
+    printf("╚═══════════════════════════════════════════════════════════════════╝\n\n");
+
+    srand(12345);
+
+    bench_partition();
+    bench_dual_pivot();
+    bench_pdqsort();
+    bench_powersort();
+    bench_radix();
+    bench_counting();
+    bench_american_flag();
+    bench_batch();
+    bench_stable();
+    bench_select();
+    bench_quantiles();
+#if HYDRA_RADIX_WC
+    bench_scatter();
+#endif
+
+    printf("Benchmark complete!\n");
+
+#if HYDRA_PLATFORM_PICO
+    while (1) {
+        tight_loop_contents();
+    }
+#endif
+
+    return 0;
+}
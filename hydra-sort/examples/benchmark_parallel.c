@@ -0,0 +1,325 @@
+/**
+ * HYDRA-SORT Parallel Utilisation Benchmark
+ *
+ * Measures how busy each worker stays during the block-sort phase on
+ * skewed inputs, comparing the shared range pool against a static
+ * round-robin split of the same blocks. Also times the radix passes on
+ * one core against the same passes split over every worker, and a CSR
+ * segmented sort against one hydra_sort call per row.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hydra_sort_v2.h"
+
+// Number of iterations for averaging
+#define ITERATIONS 5
+
+// Worker count (0 = every core the backend offers)
+#ifndef BENCH_WORKERS
+#define BENCH_WORKERS 0
+#endif
+
+#if HYDRA_PLATFORM_PICO
+#define MAX_SIZE (HYDRA_BLOCK_SIZE * 5)
+#else
+#define MAX_SIZE (HYDRA_BLOCK_SIZE * 256)
+#endif
+
+// Buffers
+static int32_t data_original[MAX_SIZE];
+static int32_t data_work[MAX_SIZE];
+static int32_t aux_buffer[MAX_SIZE];
+
+// ─── Input generators ───────────────────────────────────────────────────────
+
+// Uniform random (control)
+static void fill_random(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand();
+}
+
+// First quarter all equal: those blocks hit the heapsort fallback
+static void fill_dup_head(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (i < n / 4) ? 7 : rand();
+}
+
+// First half already sorted: cheap blocks next to expensive ones
+static void fill_sorted_head(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (i < n / 2) ? (int32_t)i : rand();
+}
+
+// ─── Static round-robin baseline ────────────────────────────────────────────
+
+typedef struct {
+    int32_t* arr;
+    size_t n;
+    uint64_t busy_us[HYDRA_MAX_WORKERS];
+} StaticJob;
+
+static void static_worker(void* arg, unsigned worker, unsigned workers) {
+    StaticJob* job = (StaticJob*)arg;
+    size_t num_blocks = (job->n + HYDRA_BLOCK_SIZE - 1) / HYDRA_BLOCK_SIZE;
+    uint64_t t0 = hydra_clock_us();
+
+    for (size_t b = worker; b < num_blocks; b += workers) {
+        size_t start = b * HYDRA_BLOCK_SIZE;
+        size_t len = (start + HYDRA_BLOCK_SIZE <= job->n) ? HYDRA_BLOCK_SIZE : (job->n - start);
+        hydra_introsort(job->arr + start, len);
+    }
+    job->busy_us[worker] = hydra_clock_us() - t0;
+}
+
+// ─── Benchmark ──────────────────────────────────────────────────────────────
+
+static float utilisation(const uint64_t* busy, unsigned workers, uint64_t wall) {
+    uint64_t total = 0;
+    for (unsigned w = 0; w < workers; w++) total += busy[w];
+    return wall ? 100.0f * (float)total / ((float)workers * (float)wall) : 100.0f;
+}
+
+static void run_benchmark(const char* name, size_t n, void (*fill_func)(int32_t*, size_t)) {
+    static HydraParallelStats stats;
+    static StaticJob job;
+    uint64_t static_wall = 0, pool_wall = 0;
+    float static_util = 0, pool_util = 0;
+    size_t shared = 0;
+    unsigned workers = hydra_backend_workers();
+
+    for (int iter = 0; iter < ITERATIONS; iter++) {
+        fill_func(data_original, n);
+
+        // Static round-robin blocks
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        job.arr = data_work;
+        job.n = n;
+        memset(job.busy_us, 0, sizeof(job.busy_us));
+        uint64_t start = hydra_clock_us();
+        hydra_backend_run(static_worker, &job);
+        uint64_t wall = hydra_clock_us() - start;
+        static_wall += wall;
+        static_util += utilisation(job.busy_us, workers, wall);
+
+        // Shared range pool (block phase of hydra_parallel_sort)
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        hydra_set_parallel_stats(&stats);
+        hydra_parallel_sort(data_work, aux_buffer, n, HYDRA_BLOCK_SIZE);
+        hydra_set_parallel_stats(NULL);
+        pool_wall += stats.wall_us;
+        pool_util += utilisation(stats.busy_us, stats.workers, stats.wall_us);
+        shared += stats.ranges_shared;
+    }
+
+    printf("│ %-12s │ %7zu │ %9.1f │ %5.1f%% │ %9.1f │ %5.1f%% │ %6zu │\n",
+           name, n,
+           (float)static_wall / ITERATIONS, static_util / ITERATIONS,
+           (float)pool_wall / ITERATIONS, pool_util / ITERATIONS,
+           shared / ITERATIONS);
+}
+
+// ─── Parallel radix ─────────────────────────────────────────────────────────
+
+static void fill_range16(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = rand() % 65536 - 32768;
+}
+
+static void fill_range22(int32_t* arr, size_t n) {
+    for (size_t i = 0; i < n; i++) arr[i] = (int32_t)((((uint32_t)rand() << 8) ^ (uint32_t)rand()) & 0x3FFFFF);
+}
+
+static bool is_sorted_i32(const int32_t* arr, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (arr[i] < arr[i-1]) return false;
+    }
+    return true;
+}
+
+static bool is_sorted_u16(const uint16_t* arr, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (arr[i] < arr[i-1]) return false;
+    }
+    return true;
+}
+
+static void run_radix(const char* name, size_t n, void (*fill_func)(int32_t*, size_t)) {
+    uint64_t serial = 0, parallel = 0;
+    bool ok = true;
+
+    for (int iter = 0; iter < ITERATIONS; iter++) {
+        fill_func(data_original, n);
+        HydraFeatures f = hydra_analyze(data_original, n);
+
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        uint64_t start = hydra_clock_us();
+        hydra_radix_sort_i32(data_work, aux_buffer, n, f.min_val, f.range_log2);
+        serial += hydra_clock_us() - start;
+        if (!is_sorted_i32(data_work, n)) ok = false;
+
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        start = hydra_clock_us();
+        hydra_parallel_radix_sort(data_work, aux_buffer, n, f.min_val, f.range_log2);
+        parallel += hydra_clock_us() - start;
+        if (!is_sorted_i32(data_work, n)) ok = false;
+    }
+
+    printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+           name, n, (float)serial / ITERATIONS, (float)parallel / ITERATIONS,
+           (float)serial / (float)parallel, ok ? " OK " : "FAIL");
+}
+
+static void run_radix_u16(size_t n) {
+    uint16_t* shorts = (uint16_t*)data_work;
+    uint16_t* shorts_aux = (uint16_t*)aux_buffer;
+    uint64_t serial = 0, parallel = 0;
+    bool ok = true;
+
+    for (int iter = 0; iter < ITERATIONS; iter++) {
+        for (size_t i = 0; i < n; i++) shorts[i] = (uint16_t)rand();
+        uint64_t start = hydra_clock_us();
+        hydra_counting_sort_u16(shorts, shorts_aux, n);
+        serial += hydra_clock_us() - start;
+        if (!is_sorted_u16(shorts, n)) ok = false;
+
+        for (size_t i = 0; i < n; i++) shorts[i] = (uint16_t)rand();
+        start = hydra_clock_us();
+        hydra_parallel_counting_sort_u16(shorts, shorts_aux, n);
+        parallel += hydra_clock_us() - start;
+        if (!is_sorted_u16(shorts, n)) ok = false;
+    }
+
+    printf("│ %-12s │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+           "uint16", n, (float)serial / ITERATIONS, (float)parallel / ITERATIONS,
+           (float)serial / (float)parallel, ok ? " OK " : "FAIL");
+}
+
+// ─── Segmented sort ─────────────────────────────────────────────────────────
+
+static size_t seg_offsets[MAX_SIZE / 8 + 2];
+
+// Power-law row lengths (most rows tiny, a few huge), like graph degrees
+static size_t fill_csr(size_t n) {
+    size_t segments = 0, off = 0;
+    seg_offsets[0] = 0;
+    while (off < n && segments < MAX_SIZE / 8) {
+        size_t len = 1 + (size_t)rand() % 16;
+        while (len < n / 4 && rand() % 4 == 0) len *= 4;
+        if (off + len > n) len = n - off;
+        off += len;
+        seg_offsets[++segments] = off;
+    }
+    seg_offsets[segments] = n;
+    fill_random(data_original, n);
+    return segments;
+}
+
+static void run_segments(size_t n) {
+    uint64_t per_row = 0, segmented = 0;
+    size_t segments = 0;
+    bool ok = true;
+
+    for (int iter = 0; iter < ITERATIONS; iter++) {
+        segments = fill_csr(n);
+
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        uint64_t start = hydra_clock_us();
+        for (size_t i = 0; i < segments; i++) {
+            size_t lo = seg_offsets[i];
+            hydra_sort(data_work + lo, seg_offsets[i + 1] - lo, aux_buffer + lo,
+                       HYDRA_PROFILE_BALANCED);
+        }
+        per_row += hydra_clock_us() - start;
+
+        memcpy(data_work, data_original, n * sizeof(int32_t));
+        start = hydra_clock_us();
+        hydra_sort_segments(data_work, seg_offsets, segments, aux_buffer, HYDRA_PROFILE_BALANCED);
+        segmented += hydra_clock_us() - start;
+        for (size_t i = 0; i < segments; i++) {
+            size_t lo = seg_offsets[i];
+            if (!is_sorted_i32(data_work + lo, seg_offsets[i + 1] - lo)) ok = false;
+        }
+    }
+
+    printf("│ %7zu rows │ %7zu │ %10.1f │ %10.1f │ %5.2fx │ %s │\n",
+           segments, n, (float)per_row / ITERATIONS, (float)segmented / ITERATIONS,
+           (float)per_row / (float)segmented, ok ? " OK " : "FAIL");
+}
+
+int main() {
+#if HYDRA_PLATFORM_PICO
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    hydra_set_workers(BENCH_WORKERS);
+    hydra_init();
+
+    printf("\n");
+    printf("╔══════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║              HYDRA-SORT PARALLEL UTILISATION BENCHMARK                   ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════╝\n\n");
+    printf("Workers: %u, block size: %u (block-sort phase only)\n\n",
+           hydra_backend_workers(), (unsigned)HYDRA_BLOCK_SIZE);
+
+    srand(12345);
+
+    static const size_t sizes[] = {
+        HYDRA_BLOCK_SIZE * 2 + HYDRA_BLOCK_SIZE / 2,
+        HYDRA_BLOCK_SIZE * 5,
+#if !HYDRA_PLATFORM_PICO
+        HYDRA_BLOCK_SIZE * 33,
+        HYDRA_BLOCK_SIZE * 256,
+#endif
+    };
+    static const struct {
+        const char* name;
+        void (*fill)(int32_t*, size_t);
+    } inputs[] = {
+        {"Random", fill_random},
+        {"DupHead", fill_dup_head},
+        {"SortedHead", fill_sorted_head},
+    };
+
+    printf("┌──────────────┬─────────┬───────────┬────────┬───────────┬────────┬────────┐\n");
+    printf("│ Input        │ Size    │ Static µs │ Util   │ Pool µs   │ Util   │ Shared │\n");
+    printf("├──────────────┼─────────┼───────────┼────────┼───────────┼────────┼────────┤\n");
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+            run_benchmark(inputs[i].name, sizes[j], inputs[i].fill);
+        }
+    }
+
+    printf("└──────────────┴─────────┴───────────┴────────┴───────────┴────────┴────────┘\n\n");
+
+    printf("Radix passes: one core vs split over %u workers (µs)\n", hydra_backend_workers());
+    printf("┌──────────────┬─────────┬────────────┬────────────┬────────┬──────┐\n");
+    printf("│ Input        │ Size    │     Serial │   Parallel │ Speed  │ Check│\n");
+    printf("├──────────────┼─────────┼────────────┼────────────┼────────┼──────┤\n");
+    for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+        run_radix("Range 2^16", sizes[j], fill_range16);
+        run_radix("Range 2^22", sizes[j], fill_range22);
+        run_radix_u16(sizes[j]);
+    }
+    printf("└──────────────┴─────────┴────────────┴────────────┴────────┴──────┘\n\n");
+
+    printf("CSR rows: hydra_sort per row vs hydra_sort_segments (µs)\n");
+    printf("┌──────────────┬─────────┬────────────┬────────────┬────────┬──────┐\n");
+    printf("│ Segments     │ Size    │    Per row │  Segmented │ Speed  │ Check│\n");
+    printf("├──────────────┼─────────┼────────────┼────────────┼────────┼──────┤\n");
+    for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); j++) {
+        run_segments(sizes[j]);
+    }
+    printf("└──────────────┴─────────┴────────────┴────────────┴────────┴──────┘\n\n");
+
+    hydra_deinit();
+
+    printf("Benchmark complete!\n");
+
+#if HYDRA_PLATFORM_PICO
+    while (1) {
+        tight_loop_contents();
+    }
+#endif
+
+    return 0;
+}
@@ -14,11 +14,43 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <string.h>
+
+// RP2040 builds get PICO_ON_DEVICE from the SDK; anything else is a host build
+#if !defined(HYDRA_PLATFORM_PICO) && !defined(HYDRA_PLATFORM_HOST)
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#define HYDRA_PLATFORM_PICO 1
+#else
+#define HYDRA_PLATFORM_HOST 1
+#endif
+#endif
+
+// Worker backend: core1 on the RP2040, pthreads on hosts, or none at all
+#if !defined(HYDRA_BACKEND_PICO) && !defined(HYDRA_BACKEND_PTHREAD) && !defined(HYDRA_BACKEND_SERIAL)
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_BACKEND_PICO 1
+#else
+#define HYDRA_BACKEND_PTHREAD 1
+#endif
+#endif
+
+#if HYDRA_PLATFORM_PICO
 #include "pico/stdlib.h"
 #include "pico/multicore.h"
 #include "hardware/dma.h"
 #include "hardware/pio.h"
 #include "hardware/sync.h"
+#else
+#include <time.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#endif
+
+#if HYDRA_BACKEND_PTHREAD
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
 
 // ═══════════════════════════════════════════════════════════════════════════
 // CONFIGURATION
@@ -30,9 +62,100 @@
 #define HYDRA_RADIX_THRESHOLD   256
 #define HYDRA_BLOCK_SIZE        4096
 #define HYDRA_PRESORT_THRESHOLD 242     // 0.95 * 255
+#define HYDRA_DUPLICATE_THRESHOLD 8     // ~3% equal neighbours: about 32 keys or fewer
+#define HYDRA_RUN_THRESHOLD     64      // Mean run length that makes powersort pay
+#define HYDRA_INSERTION_PRESORT_MAX 1024 // Largest nearly sorted input for insertion sort
+#define HYDRA_SHARE_THRESHOLD   2048    // Smallest subrange handed to idle workers
+#define HYDRA_TASK_STACK        256     // Shared subranges in flight per sort
+
+#ifndef HYDRA_MAX_WORKERS
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_MAX_WORKERS       2       // core0 + core1
+#else
+#define HYDRA_MAX_WORKERS       64      // Upper bound for host thread pools
+#endif
+#endif
+
+// Widest radix digit. Fused histograms keep one 2^bits table per digit:
+// 24 KB of stack at 11 bits on hosts, 4 KB per core at 8 bits on the RP2040
+#ifndef HYDRA_RADIX_DIGIT_BITS
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_RADIX_DIGIT_BITS  8
+#else
+#define HYDRA_RADIX_DIGIT_BITS  11
+#endif
+#endif
+
+#define HYDRA_RADIX_BUCKETS     (1u << HYDRA_RADIX_DIGIT_BITS)
+#define HYDRA_RADIX_DIGITS      ((32 + HYDRA_RADIX_DIGIT_BITS - 1) / HYDRA_RADIX_DIGIT_BITS)
+#define HYDRA_RADIX_HIST_WORDS  (HYDRA_RADIX_DIGITS * HYDRA_RADIX_BUCKETS > 4 * 256 ? \
+                                 HYDRA_RADIX_DIGITS * HYDRA_RADIX_BUCKETS : 4 * 256)
+
+// Write-combining radix scatter: staged per bucket and flushed a cache line
+// at a time. Useless without a cache, so compiled out on the RP2040.
+#ifndef HYDRA_RADIX_WC
+#define HYDRA_RADIX_WC          (!HYDRA_PLATFORM_PICO)
+#endif
+#define HYDRA_RADIX_WC_THRESHOLD 524288 // Elements before the staged scatter pays
+#define HYDRA_WC_LINE           16      // int32 per 64-byte cache line
+
+// Default int32 counting sort histogram budget, in buckets (values in range)
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_COUNTING_BUDGET   4096    // 16 KB: 12-bit ADC samples
+#else
+#define HYDRA_COUNTING_BUDGET   65536   // 256 KB: about an L2
+#endif
+
+#define HYDRA_FLAG_BITS         8       // In-place MSD radix digit width
+#define HYDRA_FLAG_BUCKETS      (1 << HYDRA_FLAG_BITS)
+#define HYDRA_FLAG_INSERTION    64      // MSD buckets this small go to insertion sort
+
+#define HYDRA_TOPK_HEAP_DIV     256     // Top-k with k <= n / this keeps a heap instead of selecting
+#define HYDRA_QUANTILE_RANKS    16      // Quantile ranks resolved by the same passes
+
+// Radix passes split over the workers past this size (two fork-joins a pass)
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_PARALLEL_RADIX_THRESHOLD 8192
+#else
+#define HYDRA_PARALLEL_RADIX_THRESHOLD 65536
+#endif
+
+#define HYDRA_MIN_GALLOP        7       // Consecutive wins before a merge gallops
+#define HYDRA_MIN_RUN           32      // Natural runs shorter than this are extended
+#define HYDRA_RUN_STACK         64      // Pending runs (powersort keeps this O(log n))
+#define HYDRA_MERGE_BUFFER_DIV  32      // Powersort wants aux >= n/32, else pdqsort
+#define HYDRA_PARTITION_BLOCK_SIZE 64   // Offsets buffered per side (fits uint8_t)
+#define HYDRA_SAMPLE_BUCKETS    64      // Max range buckets for sample sort
+#define HYDRA_SAMPLE_OVERSAMPLE 16      // Sample elements per bucket
+#define HYDRA_BATCH_MAX         64      // Largest batch array sorted by a network
+#define HYDRA_BATCH_CHUNK       256     // Batch arrays a worker claims at a time
+#define HYDRA_BATCH_PARALLEL    4096    // Batch arrays before the workers join in
+#define HYDRA_SEGMENT_CHUNK     4096    // Segment elements a worker claims at a time
+
+// Batched networks run across HYDRA_BATCH_LANES arrays at once in vector
+// registers (GCC vector extensions: SSE/AVX or NEON). The M0+ has no SIMD.
+#ifndef HYDRA_BATCH_SIMD
+#define HYDRA_BATCH_SIMD        (!HYDRA_PLATFORM_PICO)
+#endif
+#define HYDRA_BATCH_LANES       8
+
+// Records larger than this are tag sorted and then moved once, instead of
+// moved on every radix pass. Hosts cross over between 32 and 64 bytes; the
+// RP2040's 8-bit digits mean four passes, so the tag pays off sooner there.
+#ifndef HYDRA_RECORD_TAG_BYTES
+#if HYDRA_PLATFORM_PICO
+#define HYDRA_RECORD_TAG_BYTES  16
+#else
+#define HYDRA_RECORD_TAG_BYTES  48
+#endif
+#endif
 
 // RAM function placement for speed
+#if HYDRA_PLATFORM_PICO
 #define HYDRA_RAMFUNC __attribute__((section(".time_critical.hydra")))
+#else
+#define HYDRA_RAMFUNC
+#endif
 #define HYDRA_INLINE  __attribute__((always_inline)) static inline
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -43,6 +166,7 @@ typedef enum {
     HYDRA_PROFILE_ULTRA_FAST,   // Maximum speed, damn the power
     HYDRA_PROFILE_BALANCED,     // Good speed, reasonable power
     HYDRA_PROFILE_LOW_POWER,    // Minimum energy consumption
+    HYDRA_PROFILE_STABLE,       // Stable engines only: equal keys keep their order
 } HydraProfile;
 
 typedef enum {
@@ -52,10 +176,15 @@ typedef enum {
     ALG_INSERTION_SENTINEL,
     ALG_SHELL_CIURA,
     ALG_RADIX_256,
+    ALG_RADIX_INPLACE,
     ALG_QUICKSORT_DUAL_PIVOT,
     ALG_INTROSORT,
+    ALG_PDQSORT,
+    ALG_POWERSORT,
     ALG_COUNTING_U8,
     ALG_COUNTING_U16,
+    ALG_COUNTING_I32,
+    ALG_INSERTION,              // Plain insertion sort (stable, no sentinel swap)
 } HydraAlgorithm;
 
 typedef struct {
@@ -63,6 +192,8 @@ typedef struct {
     uint8_t presort;            // 0-255 scale
     uint8_t range_log2;
     uint8_t entropy;
+    uint8_t duplicates;         // 0-255 scale, share of equal neighbours
+    size_t runs;                // Monotone runs (fewer of ascending/descending)
     int32_t min_val;
     int32_t max_val;
 } HydraFeatures;
@@ -74,6 +205,21 @@ typedef struct {
     size_t block_size;
 } HydraStrategy;
 
+typedef struct {
+    int32_t* arr;
+    size_t n;
+} HydraSlice;
+
+typedef enum {
+    HYDRA_PARTITION_LOMUTO,     // Median-of-three Lomuto, one branch per element
+    HYDRA_PARTITION_BLOCK,      // BlockQuicksort: branchless offset buffers
+} HydraPartitionScheme;
+
+typedef enum {
+    HYDRA_PARALLEL_MERGE,       // Block sort + cascade merge (default)
+    HYDRA_PARALLEL_SAMPLE,      // Sample sort: disjoint value ranges, no merge
+} HydraParallelMode;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // BRANCHLESS PRIMITIVES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -94,15 +240,14 @@ HYDRA_INLINE int32_t hydra_max(int32_t a, int32_t b) {
 
 /**
  * Branchless conditional swap (sorts a,b so a <= b)
+ * Compares instead of subtracting, so it cannot overflow
  */
 HYDRA_INLINE void hydra_minmax(int32_t* a, int32_t* b) {
     int32_t x = *a, y = *b;
-    int32_t diff = x - y;
-    int32_t mask = diff >> 31;  // -1 if x < y, 0 otherwise
-    // If x > y (mask=0), we need to swap
-    // If x <= y (mask=-1), no swap needed
-    *a = x ^ ((x ^ y) & ~mask & -(diff != 0));
-    *b = y ^ ((x ^ y) & ~mask & -(diff != 0));
+    int32_t mask = -(x > y);    // -1 if a swap is needed, 0 otherwise
+    int32_t flip = (x ^ y) & mask;
+    *a = x ^ flip;
+    *b = y ^ flip;
 }
 
 /**
@@ -132,10 +277,10 @@ HYDRA_INLINE uint32_t hydra_log2(uint32_t n) {
  * ~30 cycles total
  */
 HYDRA_RAMFUNC void hydra_sort4(int32_t arr[4]) {
-    register int32_t r0 = arr[0];
-    register int32_t r1 = arr[1];
-    register int32_t r2 = arr[2];
-    register int32_t r3 = arr[3];
+    int32_t r0 = arr[0];
+    int32_t r1 = arr[1];
+    int32_t r2 = arr[2];
+    int32_t r3 = arr[3];
     
     // Network: (0,1)(2,3)(0,2)(1,3)(1,2)
     HYDRA_SWAP(r0, r1);
@@ -153,14 +298,14 @@ HYDRA_RAMFUNC void hydra_sort4(int32_t arr[4]) {
  * ~150 cycles total
  */
 HYDRA_RAMFUNC void hydra_sort8(int32_t arr[8]) {
-    register int32_t r0 = arr[0];
-    register int32_t r1 = arr[1];
-    register int32_t r2 = arr[2];
-    register int32_t r3 = arr[3];
-    register int32_t r4 = arr[4];
-    register int32_t r5 = arr[5];
-    register int32_t r6 = arr[6];
-    register int32_t r7 = arr[7];
+    int32_t r0 = arr[0];
+    int32_t r1 = arr[1];
+    int32_t r2 = arr[2];
+    int32_t r3 = arr[3];
+    int32_t r4 = arr[4];
+    int32_t r5 = arr[5];
+    int32_t r6 = arr[6];
+    int32_t r7 = arr[7];
     
     // Batcher's odd-even mergesort network (19 comparators)
     HYDRA_SWAP(r0, r1); HYDRA_SWAP(r2, r3); HYDRA_SWAP(r4, r5); HYDRA_SWAP(r6, r7);
@@ -176,7 +321,7 @@ HYDRA_RAMFUNC void hydra_sort8(int32_t arr[8]) {
 
 /**
  * Sort exactly 16 elements - uses stack for extra registers
- * 60 compare-exchange operations
+ * 63 compare-exchange operations (two Network-8 + Batcher odd-even merge)
  * ~500 cycles total
  */
 HYDRA_RAMFUNC void hydra_sort16(int32_t arr[16]) {
@@ -185,26 +330,24 @@ HYDRA_RAMFUNC void hydra_sort16(int32_t arr[16]) {
     hydra_sort8(arr + 8);
     
     // Then merge network
-    register int32_t r0 = arr[0], r1 = arr[1], r2 = arr[2], r3 = arr[3];
-    register int32_t r4 = arr[4], r5 = arr[5], r6 = arr[6], r7 = arr[7];
-    register int32_t r8 = arr[8], r9 = arr[9], r10 = arr[10], r11 = arr[11];
+    int32_t r0 = arr[0], r1 = arr[1], r2 = arr[2], r3 = arr[3];
+    int32_t r4 = arr[4], r5 = arr[5], r6 = arr[6], r7 = arr[7];
+    int32_t r8 = arr[8], r9 = arr[9], r10 = arr[10], r11 = arr[11];
+    int32_t r12 = arr[12], r13 = arr[13], r14 = arr[14], r15 = arr[15];
     
-    // Odd-even merge of two sorted sequences
-    HYDRA_SWAP(r0, r8);  HYDRA_SWAP(r1, r9);  HYDRA_SWAP(r2, r10); HYDRA_SWAP(r3, r11);
-    HYDRA_SWAP(r4, arr[12]); HYDRA_SWAP(r5, arr[13]); HYDRA_SWAP(r6, arr[14]); HYDRA_SWAP(r7, arr[15]);
+    // Odd-even merge of two sorted sequences (25 comparators)
+    HYDRA_SWAP(r0, r8);  HYDRA_SWAP(r4, r12); HYDRA_SWAP(r2, r10); HYDRA_SWAP(r6, r14);
+    HYDRA_SWAP(r1, r9);  HYDRA_SWAP(r5, r13); HYDRA_SWAP(r3, r11); HYDRA_SWAP(r7, r15);
+    HYDRA_SWAP(r4, r8);  HYDRA_SWAP(r6, r10); HYDRA_SWAP(r5, r9);  HYDRA_SWAP(r7, r11);
+    HYDRA_SWAP(r2, r4);  HYDRA_SWAP(r6, r8);  HYDRA_SWAP(r10, r12);
+    HYDRA_SWAP(r3, r5);  HYDRA_SWAP(r7, r9);  HYDRA_SWAP(r11, r13);
+    HYDRA_SWAP(r1, r2);  HYDRA_SWAP(r3, r4);  HYDRA_SWAP(r5, r6);  HYDRA_SWAP(r7, r8);
+    HYDRA_SWAP(r9, r10); HYDRA_SWAP(r11, r12); HYDRA_SWAP(r13, r14);
     
     arr[0] = r0; arr[1] = r1; arr[2] = r2; arr[3] = r3;
     arr[4] = r4; arr[5] = r5; arr[6] = r6; arr[7] = r7;
     arr[8] = r8; arr[9] = r9; arr[10] = r10; arr[11] = r11;
-    
-    // Final cleanup passes
-    for (int gap = 4; gap >= 1; gap /= 2) {
-        for (int i = gap; i < 16 - gap; i += 2 * gap) {
-            for (int j = 0; j < gap; j++) {
-                hydra_minmax(&arr[i + j - gap], &arr[i + j]);
-            }
-        }
-    }
+    arr[12] = r12; arr[13] = r13; arr[14] = r14; arr[15] = r15;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -264,6 +407,16 @@ HYDRA_RAMFUNC void hydra_insertion_small(int32_t* arr, size_t n) {
     }
 }
 
+/**
+ * Sort n <= 16 elements without reading past arr[n-1]
+ */
+HYDRA_INLINE void hydra_sort_tiny(int32_t* arr, size_t n) {
+    if (n == 4) hydra_sort4(arr);
+    else if (n == 8) hydra_sort8(arr);
+    else if (n == 16) hydra_sort16(arr);
+    else hydra_insertion_small(arr, n);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SHELL SORT WITH CIURA GAPS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -296,6 +449,16 @@ HYDRA_RAMFUNC void hydra_shell_sort(int32_t* arr, size_t n) {
 // COUNTING SORT (NUCLEAR OPTION FOR SMALL ELEMENT TYPES)
 // ═══════════════════════════════════════════════════════════════════════════
 
+// Fused digit histograms (every digit counted in one read pass) need up to
+// HYDRA_RADIX_HIST_WORDS counters. Host stacks take that easily; the
+// RP2040's 2 KB stacks cannot, so there each core gets a static set.
+#if HYDRA_PLATFORM_PICO
+static uint32_t hydra_radix_hist_core[HYDRA_MAX_WORKERS][HYDRA_RADIX_HIST_WORDS];
+#define HYDRA_RADIX_HIST_DECL(name) uint32_t* name = hydra_radix_hist_core[get_core_num()]
+#else
+#define HYDRA_RADIX_HIST_DECL(name) uint32_t name[HYDRA_RADIX_HIST_WORDS]
+#endif
+
 /**
  * Counting sort for uint8_t arrays
  * Time: O(n + 256) ≈ O(n) with tiny constants
@@ -341,42 +504,99 @@ HYDRA_RAMFUNC void hydra_counting_sort_u8(uint8_t* arr, size_t n) {
 /**
  * Two-pass radix sort for uint16_t arrays
  * Time: O(2n) ≈ O(n)
+ *
+ * Both byte histograms come from one read pass; a byte that is the same
+ * for every element skips its scatter.
  */
 HYDRA_RAMFUNC void hydra_counting_sort_u16(uint16_t* arr, uint16_t* aux, size_t n) {
-    uint32_t counts[256];
+    HYDRA_RADIX_HIST_DECL(counts);
+    uint16_t* src = arr;
+    uint16_t* dst = aux;
+    
+    if (n <= 1) return;
     
-    // Pass 1: Sort by low byte
-    memset(counts, 0, sizeof(counts));
+    // Fused count: low byte in counts[0..255], high byte in counts[256..511]
+    memset(counts, 0, 2 * 256 * sizeof(uint32_t));
     for (size_t i = 0; i < n; i++) {
-        counts[arr[i] & 0xFF]++;
+        uint16_t x = arr[i];
+        counts[x & 0xFF]++;
+        counts[256 + (x >> 8)]++;
     }
     
-    uint32_t sum = 0;
-    for (int i = 0; i < 256; i++) {
-        uint32_t c = counts[i];
-        counts[i] = sum;
-        sum += c;
+    for (int byte = 0; byte < 2; byte++) {
+        uint32_t* c = counts + byte * 256;
+        int shift = byte * 8;
+        
+        // Trivial digit: nothing would move
+        if (c[(src[0] >> shift) & 0xFF] == n) continue;
+        
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++) {
+            uint32_t t = c[i];
+            c[i] = sum;
+            sum += t;
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            uint16_t x = src[i];
+            dst[c[(x >> shift) & 0xFF]++] = x;
+        }
+        
+        uint16_t* temp = src;
+        src = dst;
+        dst = temp;
     }
     
-    for (size_t i = 0; i < n; i++) {
-        aux[counts[arr[i] & 0xFF]++] = arr[i];
-    }
+    if (src != arr) memcpy(arr, src, n * sizeof(uint16_t));
+}
+
+/**
+ * Counting sort for int32 values in [min_val, max_val]
+ * Time: O(n + range), no aux buffer
+ *
+ * counts must hold max_val - min_val + 1 words. NULL uses the per-core
+ * radix histogram, so the range may then span at most HYDRA_RADIX_HIST_WORDS
+ * values (6144 on hosts, 1024 on the RP2040); wider ranges are sorted with
+ * introsort instead. The output is rewritten from the histogram, so equal
+ * keys are not told apart.
+ */
+HYDRA_RAMFUNC void hydra_introsort(int32_t* arr, size_t n);
+
+HYDRA_RAMFUNC void hydra_counting_sort_i32(int32_t* arr, size_t n, int32_t min_val,
+                                           int32_t max_val, uint32_t* counts) {
+    HYDRA_RADIX_HIST_DECL(table);
+    uint32_t base = (uint32_t)min_val;
+    uint32_t range = (uint32_t)max_val - base;
     
-    // Pass 2: Sort by high byte
-    memset(counts, 0, sizeof(counts));
-    for (size_t i = 0; i < n; i++) {
-        counts[aux[i] >> 8]++;
+    if (n <= 1) return;
+    if (!counts) {
+        if ((size_t)range + 1 > HYDRA_RADIX_HIST_WORDS) {
+            hydra_introsort(arr, n);
+            return;
+        }
+        counts = table;
     }
     
-    sum = 0;
-    for (int i = 0; i < 256; i++) {
-        uint32_t c = counts[i];
-        counts[i] = sum;
-        sum += c;
-    }
+    memset(counts, 0, ((size_t)range + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) counts[(uint32_t)arr[i] - base]++;
     
-    for (size_t i = 0; i < n; i++) {
-        arr[counts[aux[i] >> 8]++] = aux[i];
+    // Most counts are small: store four copies unconditionally and step
+    // by the count, looping only for longer runs (no per-element branch)
+    int32_t* out = arr;
+    int32_t* end = arr + n;
+    uint32_t v = 0;
+    for (; v <= range && end - out >= 4; v++) {
+        int32_t x = (int32_t)(base + v);
+        uint32_t c = counts[v];
+        out[0] = x; out[1] = x; out[2] = x; out[3] = x;
+        if (c > 4) {
+            for (uint32_t k = 4; k < c; k++) out[k] = x;
+        }
+        out += c;
+    }
+    for (; v <= range; v++) {
+        int32_t x = (int32_t)(base + v);
+        for (uint32_t c = counts[v]; c > 0; c--) *out++ = x;
     }
 }
 
@@ -384,181 +604,1023 @@ HYDRA_RAMFUNC void hydra_counting_sort_u16(uint16_t* arr, uint16_t* aux, size_t
 // RADIX SORT (BASE 256) FOR 32-BIT
 // ═══════════════════════════════════════════════════════════════════════════
 
+#if HYDRA_RADIX_WC
+static size_t hydra_radix_wc_threshold = HYDRA_RADIX_WC_THRESHOLD;
+
+/**
+ * Scatter through write-combining buffers from this size up
+ * (0 = always, SIZE_MAX = never; for A/B comparisons)
+ */
+void hydra_set_radix_wc_threshold(size_t n) {
+    hydra_radix_wc_threshold = n;
+}
+
+// Copy one staged, 64-byte aligned line out, bypassing the cache where the
+// ISA has non-temporal stores (the line will not be read again this pass)
+HYDRA_INLINE void hydra_stream_line(uint32_t* out, const uint32_t* line) {
+#if defined(__SSE2__)
+    __m128i* o = (__m128i*)out;
+    const __m128i* l = (const __m128i*)line;
+    _mm_stream_si128(o,     _mm_load_si128(l));
+    _mm_stream_si128(o + 1, _mm_load_si128(l + 1));
+    _mm_stream_si128(o + 2, _mm_load_si128(l + 2));
+    _mm_stream_si128(o + 3, _mm_load_si128(l + 3));
+#else
+    memcpy(out, line, HYDRA_WC_LINE * sizeof(uint32_t));
+#endif
+}
+
+/**
+ * Radix scatter with software write combining
+ *
+ * A plain scatter writes one element at a time to as many streams as
+ * there are buckets. Once those streams no longer fit the L1 and the TLB,
+ * nearly every store misses. Instead each bucket stages its elements in a
+ * cache-line buffer. Elements are placed by the slot their destination
+ * address will have in its line, and a full line is written out at once.
+ * A bucket's first line may start mid-line and is copied from that slot
+ * on; whatever is left over is copied at the end.
+ *
+ * offsets[] holds the exclusive prefix sums for digit ((x - base) >> shift)
+ * & mask, and is advanced like the plain scatter.
+ */
+HYDRA_RAMFUNC void hydra_scatter_wc(const uint32_t* src, uint32_t* dst, size_t n,
+                                     uint32_t* offsets, uint32_t base, int shift,
+                                     uint32_t mask) {
+    uint32_t buf[HYDRA_RADIX_BUCKETS][HYDRA_WC_LINE] __attribute__((aligned(64)));
+    uint8_t from[HYDRA_RADIX_BUCKETS];      // First staged slot of the open line
+    
+    for (uint32_t d = 0; d <= mask; d++) {
+        from[d] = (uint8_t)(((uintptr_t)(dst + offsets[d]) / sizeof(uint32_t)) & (HYDRA_WC_LINE - 1));
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x = src[i];
+        uint32_t d = ((x - base) >> shift) & mask;
+        uint32_t* out = dst + offsets[d]++;
+        size_t slot = ((uintptr_t)out / sizeof(uint32_t)) & (HYDRA_WC_LINE - 1);
+        buf[d][slot] = x;
+        
+        // Line complete: write it out
+        if (slot == HYDRA_WC_LINE - 1) {
+            out -= HYDRA_WC_LINE - 1;
+            if (from[d] == 0) {
+                hydra_stream_line(out, buf[d]);
+            } else {
+                memcpy(out + from[d], buf[d] + from[d], (HYDRA_WC_LINE - from[d]) * sizeof(uint32_t));
+                from[d] = 0;
+            }
+        }
+    }
+    
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+    
+    // Partial last lines
+    for (uint32_t d = 0; d <= mask; d++) {
+        uint32_t* end = dst + offsets[d];
+        size_t slot = ((uintptr_t)end / sizeof(uint32_t)) & (HYDRA_WC_LINE - 1);
+        if (slot > from[d]) {
+            memcpy(end - (slot - from[d]), buf[d] + from[d], (slot - from[d]) * sizeof(uint32_t));
+        }
+    }
+}
+#endif
+
 /**
- * LSD Radix sort (4 passes for 32-bit integers)
+ * LSD Radix sort (up to 4 passes for 32-bit integers)
+ *
+ * All four byte histograms come from a single read pass, so the array is
+ * read 1 + passes times instead of twice per pass. A byte that is the
+ * same for every element skips its scatter.
  */
 HYDRA_RAMFUNC void hydra_radix_sort_256(uint32_t* arr, uint32_t* aux, size_t n) {
-    uint32_t counts[256];
+    HYDRA_RADIX_HIST_DECL(counts);
+    uint32_t* src = arr;
+    uint32_t* dst = aux;
+    
+    if (n <= 1) return;
+    
+    // Fused count: byte b in counts[b*256 .. b*256+255]
+    memset(counts, 0, 4 * 256 * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x = arr[i];
+        counts[x & 0xFF]++;
+        counts[256 + ((x >> 8) & 0xFF)]++;
+        counts[512 + ((x >> 16) & 0xFF)]++;
+        counts[768 + (x >> 24)]++;
+    }
     
     for (int byte = 0; byte < 4; byte++) {
+        uint32_t* c = counts + byte * 256;
         int shift = byte * 8;
         
-        memset(counts, 0, sizeof(counts));
+        // Trivial digit: nothing would move
+        if (c[(src[0] >> shift) & 0xFF] == n) continue;
+        
+        // Prefix sum
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++) {
+            uint32_t t = c[i];
+            c[i] = sum;
+            sum += t;
+        }
+        
+        // Scatter
+#if HYDRA_RADIX_WC
+        if (n >= hydra_radix_wc_threshold) {
+            hydra_scatter_wc(src, dst, n, c, 0, shift, 0xFF);
+        } else
+#endif
+        for (size_t i = 0; i < n; i++) {
+            uint32_t x = src[i];
+            dst[c[(x >> shift) & 0xFF]++] = x;
+        }
         
-        // Count
+        // Swap
+        uint32_t* temp = src;
+        src = dst;
+        dst = temp;
+    }
+    
+    // Odd number of scatters: the result is in aux
+    if (src != arr) memcpy(arr, src, n * sizeof(uint32_t));
+}
+
+/**
+ * Split range_log2 + 1 significant bits evenly over the fewest digits of
+ * at most HYDRA_RADIX_DIGIT_BITS; returns the number of digits
+ */
+HYDRA_INLINE int hydra_radix_plan(uint8_t range_log2, int* shifts, uint32_t* masks) {
+    int bits = range_log2 + 1;
+    int passes = (bits + HYDRA_RADIX_DIGIT_BITS - 1) / HYDRA_RADIX_DIGIT_BITS;
+    for (int pass = 0, shift = 0; pass < passes; pass++) {
+        int width = (bits - shift + (passes - pass) - 1) / (passes - pass);
+        shifts[pass] = shift;
+        masks[pass] = (1u << width) - 1;
+        shift += width;
+    }
+    return passes;
+}
+
+/**
+ * Signed, range-compressed LSD radix sort for int32
+ *
+ * Sorts the key x - min_val as unsigned, which both orders negative
+ * values correctly (the subtraction removes the sign) and leaves only
+ * range_log2 + 1 significant bits. Those bits are split into the fewest
+ * digits of at most HYDRA_RADIX_DIGIT_BITS (e.g. 11/11/10 for a full
+ * 32-bit range, 10/10 for a 20-bit one), and a pass whose digit is the
+ * same for every element is skipped. All digit histograms come from one
+ * read pass before the first scatter.
+ *
+ * min_val and range_log2 come from hydra_analyze; aux must hold n.
+ * counts is the HYDRA_RADIX_HIST_WORDS digit table (see hydra_radix_sort_i32).
+ */
+HYDRA_RAMFUNC void hydra_radix_sort_i32_hist(int32_t* arr, int32_t* aux, size_t n,
+                                             int32_t min_val, uint8_t range_log2,
+                                             uint32_t* counts) {
+    uint32_t base = (uint32_t)min_val;
+    int32_t* src = arr;
+    int32_t* dst = aux;
+    
+    if (n <= 1) return;
+    
+    int shifts[HYDRA_RADIX_DIGITS];
+    uint32_t masks[HYDRA_RADIX_DIGITS];
+    int passes = hydra_radix_plan(range_log2, shifts, masks);
+    
+    // Fused count: digit p in counts[p*BUCKETS ..], one read pass for all
+    // (two and three digits spelled out, the common host cases)
+    memset(counts, 0, (size_t)passes * HYDRA_RADIX_BUCKETS * sizeof(uint32_t));
+    uint32_t* c0 = counts;
+    uint32_t* c1 = counts + HYDRA_RADIX_BUCKETS;
+    uint32_t* c2 = counts + 2 * HYDRA_RADIX_BUCKETS;
+    if (passes == 2) {
         for (size_t i = 0; i < n; i++) {
-            counts[(arr[i] >> shift) & 0xFF]++;
+            uint32_t key = (uint32_t)arr[i] - base;
+            c0[key & masks[0]]++;
+            c1[key >> shifts[1]]++;
         }
+    } else if (passes == 3) {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t key = (uint32_t)arr[i] - base;
+            c0[key & masks[0]]++;
+            c1[(key >> shifts[1]) & masks[1]]++;
+            c2[key >> shifts[2]]++;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t key = (uint32_t)arr[i] - base;
+            for (int pass = 0; pass < passes; pass++) {
+                counts[pass * HYDRA_RADIX_BUCKETS + ((key >> shifts[pass]) & masks[pass])]++;
+            }
+        }
+    }
+    
+    for (int pass = 0; pass < passes; pass++) {
+        uint32_t* c = counts + pass * HYDRA_RADIX_BUCKETS;
+        int shift = shifts[pass];
+        uint32_t mask = masks[pass];
+        
+        // One digit for everything: this pass would not move anything
+        if (c[(((uint32_t)src[0] - base) >> shift) & mask] == n) continue;
         
         // Prefix sum
         uint32_t sum = 0;
-        for (int i = 0; i < 256; i++) {
-            uint32_t c = counts[i];
-            counts[i] = sum;
-            sum += c;
+        for (uint32_t d = 0; d <= mask; d++) {
+            uint32_t t = c[d];
+            c[d] = sum;
+            sum += t;
         }
         
         // Scatter
+#if HYDRA_RADIX_WC
+        if (n >= hydra_radix_wc_threshold) {
+            hydra_scatter_wc((const uint32_t*)src, (uint32_t*)dst, n, c, base, shift, mask);
+        } else
+#endif
         for (size_t i = 0; i < n; i++) {
-            uint8_t digit = (arr[i] >> shift) & 0xFF;
-            aux[counts[digit]++] = arr[i];
+            int32_t x = src[i];
+            dst[c[(((uint32_t)x - base) >> shift) & mask]++] = x;
         }
         
-        // Swap
-        uint32_t* temp = arr;
-        arr = aux;
-        aux = temp;
+        int32_t* temp = src;
+        src = dst;
+        dst = temp;
     }
     
-    // If ended on aux, copy back (4 passes = even, no copy needed)
+    // Odd number of scatters: the result is in aux
+    if (src != arr) memcpy(arr, src, n * sizeof(int32_t));
+}
+
+/**
+ * hydra_radix_sort_i32_hist with this core's own digit table
+ */
+HYDRA_RAMFUNC void hydra_radix_sort_i32(int32_t* arr, int32_t* aux, size_t n,
+                                        int32_t min_val, uint8_t range_log2) {
+    HYDRA_RADIX_HIST_DECL(counts);
+    hydra_radix_sort_i32_hist(arr, aux, n, min_val, range_log2, counts);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// MERGE OPERATIONS
+// IN-PLACE MSD RADIX (AMERICAN FLAG)
 // ═══════════════════════════════════════════════════════════════════════════
 
+/*
+ * MSD radix without an aux buffer. Each level counts the top unsorted
+ * digit, then permutes in place: an element is swapped straight into the
+ * next free slot of its digit's bucket until the element for the current
+ * slot turns up (McIlroy, Bostic & McIlroy's American flag sort). Every
+ * bucket is then sorted on the next digit down.
+ *
+ * The counts are only needed while a level permutes, so one heads/ends
+ * table serves every level and recursion finds bucket boundaries by
+ * scanning the digit. Buckets of HYDRA_FLAG_INSERTION or fewer go to the
+ * sorting networks and insertion sort. Not stable.
+ */
+
+#define HYDRA_FLAG_DIGIT(x) ((((uint32_t)(x) - base) >> shift) & mask)
+
+HYDRA_RAMFUNC void hydra_flag_sort_impl(int32_t* arr, size_t n, uint32_t base,
+                                        int top, uint32_t* table) {
+    uint32_t* heads = table;
+    uint32_t* ends = table + HYDRA_FLAG_BUCKETS;
+    
+    if (n <= HYDRA_FLAG_INSERTION) {
+        if (n <= 16) hydra_sort_tiny(arr, n);
+        else hydra_insertion_sentinel(arr, n);
+        return;
+    }
+    
+    // top = unsorted low key bits; the next digit is the highest of them
+    while (top > 0) {
+        int width = top < HYDRA_FLAG_BITS ? top : HYDRA_FLAG_BITS;
+        int shift = top - width;
+        uint32_t mask = (1u << width) - 1;
+        top = shift;
+        
+        memset(ends, 0, ((size_t)mask + 1) * sizeof(uint32_t));
+        for (size_t i = 0; i < n; i++) ends[HYDRA_FLAG_DIGIT(arr[i])]++;
+        
+        // One digit for everything: nothing to move, go one digit down
+        if (ends[HYDRA_FLAG_DIGIT(arr[0])] == n) continue;
+        
+        uint32_t sum = 0;
+        for (uint32_t d = 0; d <= mask; d++) {
+            heads[d] = sum;
+            sum += ends[d];
+            ends[d] = sum;
+        }
+        
+        // Cycle each misplaced element into its bucket
+        for (uint32_t b = 0; b <= mask; b++) {
+            while (heads[b] < ends[b]) {
+                int32_t v = arr[heads[b]];
+                uint32_t d = HYDRA_FLAG_DIGIT(v);
+                while (d != b) {
+                    int32_t t = arr[heads[d]];
+                    arr[heads[d]++] = v;
+                    v = t;
+                    d = HYDRA_FLAG_DIGIT(v);
+                }
+                arr[heads[b]++] = v;
+            }
+        }
+        
+        if (top == 0) return;
+        
+        // The table is reused below, so find each bucket by its digit
+        size_t lo = 0;
+        while (lo < n) {
+            uint32_t d = HYDRA_FLAG_DIGIT(arr[lo]);
+            size_t hi = lo + 1;
+            while (hi < n && HYDRA_FLAG_DIGIT(arr[hi]) == d) hi++;
+            if (hi - lo > 1) hydra_flag_sort_impl(arr + lo, hi - lo, base, top, table);
+            lo = hi;
+        }
+        return;
+    }
+}
+
 /**
- * Standard two-way merge with sentinel optimization
+ * In-place signed, range-compressed MSD radix sort for int32
+ *
+ * Same key as hydra_radix_sort_i32 (x - min_val over range_log2 + 1 bits),
+ * taken 8 bits at a time from the top. Needs no aux buffer; recursion is
+ * at most one level per digit.
  */
-HYDRA_RAMFUNC void hydra_merge(int32_t* a, size_t na,
-                                int32_t* b, size_t nb,
-                                int32_t* out) {
-    // Sentinel approach: caller ensures space for sentinels
-    a[na] = INT32_MAX;
-    b[nb] = INT32_MAX;
+HYDRA_RAMFUNC void hydra_american_flag_sort(int32_t* arr, size_t n,
+                                            int32_t min_val, uint8_t range_log2) {
+    HYDRA_RADIX_HIST_DECL(table);
+    if (n <= 1) return;
+    hydra_flag_sort_impl(arr, n, (uint32_t)min_val, range_log2 + 1, table);
+}
+
+HYDRA_RAMFUNC void hydra_flag_sort_u16_impl(uint16_t* arr, size_t n, int top,
+                                            uint32_t* table) {
+    uint32_t* heads = table;
+    uint32_t* ends = table + HYDRA_FLAG_BUCKETS;
+    const uint32_t base = 0;
     
-    size_t i = 0, j = 0;
-    size_t total = na + nb;
+    if (n <= HYDRA_FLAG_INSERTION) {
+        for (size_t i = 1; i < n; i++) {
+            uint16_t key = arr[i];
+            size_t j = i;
+            while (j > 0 && arr[j - 1] > key) {
+                arr[j] = arr[j - 1];
+                j--;
+            }
+            arr[j] = key;
+        }
+        return;
+    }
     
-    // Main merge loop - NO BOUNDS CHECKING
-    for (size_t k = 0; k < total; k++) {
-        if (a[i] <= b[j]) {
-            out[k] = a[i++];
-        } else {
-            out[k] = b[j++];
+    while (top > 0) {
+        int shift = top - HYDRA_FLAG_BITS;
+        uint32_t mask = HYDRA_FLAG_BUCKETS - 1;
+        top = shift;
+        
+        memset(ends, 0, HYDRA_FLAG_BUCKETS * sizeof(uint32_t));
+        for (size_t i = 0; i < n; i++) ends[HYDRA_FLAG_DIGIT(arr[i])]++;
+        
+        if (ends[HYDRA_FLAG_DIGIT(arr[0])] == n) continue;
+        
+        uint32_t sum = 0;
+        for (uint32_t d = 0; d <= mask; d++) {
+            heads[d] = sum;
+            sum += ends[d];
+            ends[d] = sum;
+        }
+        
+        for (uint32_t b = 0; b <= mask; b++) {
+            while (heads[b] < ends[b]) {
+                uint16_t v = arr[heads[b]];
+                uint32_t d = HYDRA_FLAG_DIGIT(v);
+                while (d != b) {
+                    uint16_t t = arr[heads[d]];
+                    arr[heads[d]++] = v;
+                    v = t;
+                    d = HYDRA_FLAG_DIGIT(v);
+                }
+                arr[heads[b]++] = v;
+            }
         }
+        
+        if (top == 0) return;
+        
+        size_t lo = 0;
+        while (lo < n) {
+            uint32_t d = HYDRA_FLAG_DIGIT(arr[lo]);
+            size_t hi = lo + 1;
+            while (hi < n && HYDRA_FLAG_DIGIT(arr[hi]) == d) hi++;
+            if (hi - lo > 1) hydra_flag_sort_u16_impl(arr + lo, hi - lo, top, table);
+            lo = hi;
+        }
+        return;
     }
 }
 
+/**
+ * In-place MSD radix sort for uint16_t arrays (two byte levels, no aux)
+ */
+HYDRA_RAMFUNC void hydra_american_flag_sort_u16(uint16_t* arr, size_t n) {
+    HYDRA_RADIX_HIST_DECL(table);
+    if (n <= 1) return;
+    hydra_flag_sort_u16_impl(arr, n, 16, table);
+}
+
+#undef HYDRA_FLAG_DIGIT
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MERGE OPERATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
 /**
  * Four-way merge for reduced merge passes
+ *
+ * Inputs are read-only: an exhausted input reads as INT32_MAX (a virtual
+ * sentinel) instead of having one written past its end, so runs may sit
+ * back to back in the same buffer. Only the advanced head is reloaded,
+ * which keeps the bounds check to one compare per output element.
  */
-HYDRA_RAMFUNC void hydra_merge4(int32_t* a, size_t na,
-                                 int32_t* b, size_t nb,
-                                 int32_t* c, size_t nc,
-                                 int32_t* d, size_t nd,
+HYDRA_RAMFUNC void hydra_merge4(const int32_t* a, size_t na,
+                                 const int32_t* b, size_t nb,
+                                 const int32_t* c, size_t nc,
+                                 const int32_t* d, size_t nd,
                                  int32_t* out) {
-    // Sentinels
-    a[na] = b[nb] = c[nc] = d[nd] = INT32_MAX;
-    
     size_t i = 0, j = 0, k = 0, l = 0;
     size_t total = na + nb + nc + nd;
     
+    int32_t ha = na ? a[0] : INT32_MAX;
+    int32_t hb = nb ? b[0] : INT32_MAX;
+    int32_t hc = nc ? c[0] : INT32_MAX;
+    int32_t hd = nd ? d[0] : INT32_MAX;
+    
     for (size_t m = 0; m < total; m++) {
         // Tournament tree: compare pairs, then compare winners
         int32_t min_ab, min_cd;
         int from_a, from_c;
         
-        if (a[i] <= b[j]) {
-            min_ab = a[i]; from_a = 1;
+        if (ha <= hb) {
+            min_ab = ha; from_a = 1;
         } else {
-            min_ab = b[j]; from_a = 0;
+            min_ab = hb; from_a = 0;
         }
         
-        if (c[k] <= d[l]) {
-            min_cd = c[k]; from_c = 1;
+        if (hc <= hd) {
+            min_cd = hc; from_c = 1;
         } else {
-            min_cd = d[l]; from_c = 0;
+            min_cd = hd; from_c = 0;
         }
         
         if (min_ab <= min_cd) {
             out[m] = min_ab;
-            if (from_a) i++; else j++;
+            if (from_a) ha = (++i < na) ? a[i] : INT32_MAX;
+            else        hb = (++j < nb) ? b[j] : INT32_MAX;
         } else {
             out[m] = min_cd;
-            if (from_c) k++; else l++;
+            if (from_c) hc = (++k < nc) ? c[k] : INT32_MAX;
+            else        hd = (++l < nd) ? d[l] : INT32_MAX;
         }
     }
 }
 
-// ═══════════════════════════════════════════════════════════════════════════
-// INPUT ANALYSIS
-// ═══════════════════════════════════════════════════════════════════════════
+/**
+ * Number of elements in sorted arr[0..n) that are < key
+ */
+HYDRA_INLINE size_t hydra_lower_bound(const int32_t* arr, size_t n, int32_t key) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (arr[lo + half] < key) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return lo;
+}
 
 /**
- * Analyze input array to determine optimal algorithm
- * Single O(n) pass collecting all statistics
+ * Number of elements in sorted arr[0..n) that are <= key
  */
-HYDRA_RAMFUNC HydraFeatures hydra_analyze(const int32_t* arr, size_t n) {
-    HydraFeatures f = {0};
-    f.n = n;
-    
-    if (n <= 1) {
-        f.presort = 255;
-        return f;
+HYDRA_INLINE size_t hydra_upper_bound(const int32_t* arr, size_t n, int32_t key) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (arr[lo + half] <= key) {
+            lo += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
     }
-    
-    int32_t min_val = arr[0];
-    int32_t max_val = arr[0];
-    size_t runs = 1;
-    
-    for (size_t i = 1; i < n; i++) {
-        if (arr[i] < arr[i-1]) runs++;
-        if (arr[i] < min_val) min_val = arr[i];
-        if (arr[i] > max_val) max_val = arr[i];
+    return lo;
+}
+
+/**
+ * Galloping search: count of elements in sorted arr[0..n) that are < key
+ * (or <= key when inclusive). Probes 1, 3, 7, ... from the front, then
+ * binary-searches the last gap, so a short answer costs O(log answer).
+ */
+HYDRA_INLINE size_t hydra_gallop(const int32_t* arr, size_t n, int32_t key, bool inclusive) {
+    size_t prev = 0, ofs = 1;
+    while (ofs < n && (inclusive ? arr[ofs - 1] <= key : arr[ofs - 1] < key)) {
+        prev = ofs;
+        ofs = 2 * ofs + 1;
     }
+    if (ofs > n) ofs = n;
+    return prev + (inclusive ? hydra_upper_bound(arr + prev, ofs - prev, key)
+                             : hydra_lower_bound(arr + prev, ofs - prev, key));
+}
+
+/**
+ * Stable two-way merge with galloping (TimSort)
+ *
+ * Takes a on ties. After HYDRA_MIN_GALLOP consecutive wins from one side
+ * it switches to galloping, copying whole stretches found by
+ * hydra_gallop, and drops back once stretches get short again. Inputs
+ * are read-only with bounds checks instead of sentinels; out may overlap
+ * b as long as it starts at least na elements before it (merging a run
+ * copied out of arr back in front of its neighbour).
+ */
+HYDRA_RAMFUNC void hydra_merge(const int32_t* a, size_t na,
+                                const int32_t* b, size_t nb,
+                                int32_t* out) {
+    size_t i = 0, j = 0, k = 0;
+    size_t min_gallop = HYDRA_MIN_GALLOP;
     
-    f.min_val = min_val;
-    f.max_val = max_val;
-    
-    // Presortedness: 255 = fully sorted, 0 = maximally unsorted
-    f.presort = 255 - (uint8_t)((255ULL * (runs - 1)) / (n - 1));
-    
-    // Range in log2
-    uint32_t range = (uint32_t)(max_val - min_val);
-    f.range_log2 = (range > 0) ? hydra_log2(range) : 0;
+    while (i < na && j < nb) {
+        // One element at a time (branchless select) until one side keeps
+        // winning
+        size_t wins_a = 0, wins_b = 0;
+        do {
+            int32_t x = a[i], y = b[j];
+            size_t take_b = (y < x);
+            out[k++] = take_b ? y : x;
+            j += take_b;
+            i += take_b ^ 1;
+            wins_b = (wins_b + 1) & (0 - take_b);
+            wins_a = (wins_a + 1) & (take_b - 1);
+        } while (i < na && j < nb && wins_a < min_gallop && wins_b < min_gallop);
+        
+        // Gallop while the stretches stay long
+        while (i < na && j < nb) {
+            size_t run_a = hydra_gallop(a + i, na - i, b[j], true);
+            memmove(out + k, a + i, run_a * sizeof(int32_t));
+            k += run_a; i += run_a;
+            if (i == na) break;
+            
+            size_t run_b = hydra_gallop(b + j, nb - j, a[i], false);
+            memmove(out + k, b + j, run_b * sizeof(int32_t));
+            k += run_b; j += run_b;
+            if (j == nb) break;
+            
+            if (run_a < HYDRA_MIN_GALLOP && run_b < HYDRA_MIN_GALLOP) {
+                min_gallop++;
+                break;
+            }
+            if (min_gallop > 1) min_gallop--;
+        }
+    }
     
-    return f;
+    if (i < na) memmove(out + k, a + i, (na - i) * sizeof(int32_t));
+    k += na - i;
+    if (j < nb) memmove(out + k, b + j, (nb - j) * sizeof(int32_t));
 }
 
-// ═══════════════════════════════════════════════════════════════════════════
-// STRATEGY SELECTION
-// ═══════════════════════════════════════════════════════════════════════════
-
 /**
- * Select optimal sorting strategy based on input features
+ * Split four sorted runs so that exactly `rank` elements fall on the left
+ * and none of them is greater than anything on the right.
+ *
+ * Binary-searches the value domain (32 steps), then hands tied keys to the
+ * earlier runs first. Merging each side independently reproduces the
+ * single hydra_merge4 output, which lets several cores share one merge.
  */
-HYDRA_INLINE HydraStrategy hydra_select_strategy(const HydraFeatures* f,
-                                                   HydraProfile profile) {
-    HydraStrategy s = {0};
-    size_t n = f->n;
+HYDRA_RAMFUNC void hydra_merge4_split(const int32_t* const runs[4],
+                                       const size_t lens[4],
+                                       size_t rank, size_t pos[4]) {
+    if (rank == 0) {
+        pos[0] = pos[1] = pos[2] = pos[3] = 0;
+        return;
+    }
     
-    // Tiny arrays: direct network sort
-    if (n <= 4) {
-        s.algorithm = ALG_NETWORK_4;
-        return s;
+    // Smallest key with count(<= key) >= rank, searched in biased unsigned
+    // space so the midpoint never overflows
+    uint32_t lo = 0, hi = UINT32_MAX;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int32_t key = (int32_t)(mid ^ 0x80000000u);
+        size_t count = 0;
+        for (int r = 0; r < 4; r++) {
+            count += hydra_upper_bound(runs[r], lens[r], key);
+        }
+        if (count >= rank) hi = mid; else lo = mid + 1;
     }
-    if (n <= 8) {
-        s.algorithm = ALG_NETWORK_8;
-        return s;
+    int32_t key = (int32_t)(lo ^ 0x80000000u);
+    
+    // Everything below key goes left, then ties fill the remainder in run order
+    size_t less[4], left = rank;
+    for (int r = 0; r < 4; r++) {
+        less[r] = hydra_lower_bound(runs[r], lens[r], key);
+        left -= less[r];
+    }
+    for (int r = 0; r < 4; r++) {
+        size_t ties = hydra_upper_bound(runs[r], lens[r], key) - less[r];
+        size_t take = (left < ties) ? left : ties;
+        pos[r] = less[r] + take;
+        left -= take;
+    }
+}
+
+/**
+ * One level of the cascade merge: every group of four adjacent runs of
+ * length `run` in src is merged into the same span of dst.
+ *
+ * Each group's output is cut into `parts` equal slices and only slice
+ * `part` is produced, so cores can split a level (even the final,
+ * single-group one) without any synchronisation inside it.
+ */
+HYDRA_RAMFUNC void hydra_merge_level(const int32_t* src, int32_t* dst, size_t n,
+                                      size_t run, unsigned part, unsigned parts) {
+    size_t group = run * 4;
+    
+    for (size_t g = 0; g < n; g += group) {
+        const int32_t* runs[4];
+        size_t lens[4];
+        for (int r = 0; r < 4; r++) {
+            size_t start = g + r * run;
+            if (start > n) start = n;
+            runs[r] = src + start;
+            lens[r] = (n - start < run) ? (n - start) : run;
+        }
+        
+        size_t len = lens[0] + lens[1] + lens[2] + lens[3];
+        size_t lo = len * part / parts;
+        size_t hi = len * (part + 1) / parts;
+        if (lo == hi) continue;
+        
+        size_t p0[4], p1[4];
+        hydra_merge4_split(runs, lens, lo, p0);
+        hydra_merge4_split(runs, lens, hi, p1);
+        
+        hydra_merge4(runs[0] + p0[0], p1[0] - p0[0],
+                     runs[1] + p0[1], p1[1] - p0[1],
+                     runs[2] + p0[2], p1[2] - p0[2],
+                     runs[3] + p0[3], p1[3] - p0[3],
+                     dst + g + lo);
+    }
+}
+
+/**
+ * Single-core cascade merge of sorted runs of length `run` (the last may
+ * be short). Ping-pongs between arr and aux, four runs per level; the
+ * result always ends up in arr.
+ */
+HYDRA_RAMFUNC void hydra_cascade_merge(int32_t* arr, int32_t* aux, size_t n, size_t run) {
+    int32_t* src = arr;
+    int32_t* dst = aux;
+    
+    for (; run < n; run *= 4) {
+        hydra_merge_level(src, dst, n, run, 0, 1);
+        int32_t* temp = src; src = dst; dst = temp;
+    }
+    
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int32_t));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NATURAL MERGE SORT (POWERSORT)
+// ═══════════════════════════════════════════════════════════════════════════
+
+typedef struct {
+    size_t start;
+    size_t len;
+    int power;                  // Node power of the boundary before the next run
+} HydraRun;
+
+/**
+ * Length of the natural run at arr[start..n): ascending (non-strict), or
+ * strictly descending and reversed in place. Strictness keeps it stable.
+ */
+HYDRA_INLINE size_t hydra_count_run(int32_t* arr, size_t start, size_t n) {
+    size_t end = start + 1;
+    if (end == n) return 1;
+    
+    if (arr[end] < arr[start]) {
+        while (end + 1 < n && arr[end + 1] < arr[end]) end++;
+        for (size_t lo = start, hi = end; lo < hi; lo++, hi--) {
+            int32_t t = arr[lo]; arr[lo] = arr[hi]; arr[hi] = t;
+        }
+    } else {
+        while (end + 1 < n && arr[end + 1] >= arr[end]) end++;
+    }
+    return end - start + 1;
+}
+
+/**
+ * Powersort node power of the boundary between run [s1, s1+n1) and the
+ * run of n2 that follows it: the depth at which the boundary would split
+ * [0, n) in a perfectly balanced merge tree (Munro & Wild)
+ */
+HYDRA_INLINE int hydra_node_power(size_t s1, size_t n1, size_t n2, size_t n) {
+    size_t a = 2 * s1 + n1;     // Twice the midpoint of run 1
+    size_t b = a + n1 + n2;     // Twice the midpoint of run 2
+    int power = 0;
+    
+    while (true) {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+/**
+ * Swap the adjacent blocks arr[0..left) and arr[left..left+right)
+ * (three reversals, no buffer)
+ */
+HYDRA_INLINE void hydra_rotate(int32_t* arr, size_t left, size_t right) {
+    size_t n = left + right;
+    for (size_t lo = 0, hi = left; lo + 1 < hi; lo++, hi--) {
+        int32_t t = arr[lo]; arr[lo] = arr[hi - 1]; arr[hi - 1] = t;
+    }
+    for (size_t lo = left, hi = n; lo + 1 < hi; lo++, hi--) {
+        int32_t t = arr[lo]; arr[lo] = arr[hi - 1]; arr[hi - 1] = t;
+    }
+    for (size_t lo = 0, hi = n; lo + 1 < hi; lo++, hi--) {
+        int32_t t = arr[lo]; arr[lo] = arr[hi - 1]; arr[hi - 1] = t;
+    }
+}
+
+/**
+ * Merge arr[start..mid) with arr[mid..end) in place, stably, using at
+ * most aux_len elements of aux
+ *
+ * Whichever run fits in aux is copied out (the left run merges forwards,
+ * the right run backwards). If neither fits, the longer run is split at
+ * its middle, the other at the matching key, the two inner blocks are
+ * rotated past each other and both halves merge on their own, so merges
+ * fall back to O(n log n) moves only while they are larger than aux.
+ */
+HYDRA_RAMFUNC void hydra_merge_runs(int32_t* arr, size_t start, size_t mid,
+                                     size_t end, int32_t* aux, size_t aux_len) {
+    while (true) {
+        // Left elements <= arr[mid] and right elements >= arr[mid-1] are
+        // already in place
+        if (start == mid || mid == end) return;
+        start += hydra_gallop(arr + start, mid - start, arr[mid], true);
+        if (start == mid) return;
+        end = mid + hydra_gallop(arr + mid, end - mid, arr[mid - 1], false);
+        
+        size_t na = mid - start;
+        size_t nb = end - mid;
+        if (na <= aux_len && na <= nb) {
+            memcpy(aux, arr + start, na * sizeof(int32_t));
+            hydra_merge(aux, na, arr + mid, nb, arr + start);
+            return;
+        }
+        if (nb <= aux_len) {
+            // Backwards: ties keep the right run's element last
+            memcpy(aux, arr + mid, nb * sizeof(int32_t));
+            size_t i = na, j = nb, k = na + nb;
+            int32_t* a = arr + start;
+            while (i > 0 && j > 0) {
+                if (aux[j - 1] < a[i - 1]) a[--k] = a[--i];
+                else a[--k] = aux[--j];
+            }
+            memcpy(a, aux, j * sizeof(int32_t));
+            return;
+        }
+        if (na <= aux_len) {
+            memcpy(aux, arr + start, na * sizeof(int32_t));
+            hydra_merge(aux, na, arr + mid, nb, arr + start);
+            return;
+        }
+        
+        // Neither run fits: split and rotate (left keys equal to the cut
+        // key stay before it, so the merge stays stable)
+        size_t cut_a, cut_b;
+        if (na >= nb) {
+            cut_a = na / 2;
+            cut_b = hydra_gallop(arr + mid, nb, arr[start + cut_a], false);
+        } else {
+            cut_b = nb / 2;
+            cut_a = hydra_gallop(arr + start, na, arr[mid + cut_b], true);
+        }
+        hydra_rotate(arr + start + cut_a, na - cut_a, cut_b);
+        size_t split = start + cut_a + cut_b;
+        
+        // Recurse into the smaller half, loop on the larger
+        if (cut_a + cut_b <= (na - cut_a) + (nb - cut_b)) {
+            hydra_merge_runs(arr, start, start + cut_a, split, aux, aux_len);
+            start = split;
+            mid = split + (na - cut_a);
+        } else {
+            hydra_merge_runs(arr, split, split + (na - cut_a), end, aux, aux_len);
+            end = split;
+            mid = start + cut_a;
+        }
+    }
+}
+
+/**
+ * Powersort (CPython's list.sort since 3.11)
+ *
+ * Finds natural runs, extends any shorter than HYDRA_MIN_RUN with
+ * insertion sort, and merges adjacent runs in the order given by the node
+ * power of their boundary. The merge tree is then within a constant of
+ * optimal for the run lengths: r runs cost O(n log r), so a few dozen
+ * sorted streams merge in a handful of passes and sorted input is O(n).
+ *
+ * Each merge copies its shorter run into aux; with aux_len below that,
+ * the merge splits and rotates in place (aux may be NULL with aux_len 0).
+ */
+HYDRA_RAMFUNC void hydra_powersort_buffer(int32_t* arr, size_t n, int32_t* aux, size_t aux_len) {
+    if (n <= 1) return;
+    
+    HydraRun stack[HYDRA_RUN_STACK];
+    size_t top = 0;
+    size_t start = 0;
+    
+    while (start < n) {
+        size_t len = hydra_count_run(arr, start, n);
+        
+        // Short run: extend to HYDRA_MIN_RUN with insertion sort
+        if (len < HYDRA_MIN_RUN && start + len < n) {
+            size_t ext = (n - start < HYDRA_MIN_RUN) ? n - start : HYDRA_MIN_RUN;
+            int32_t* run = arr + start;
+            for (size_t i = len; i < ext; i++) {
+                int32_t key = run[i];
+                size_t j = i;
+                while (j > 0 && run[j - 1] > key) {
+                    run[j] = run[j - 1];
+                    j--;
+                }
+                run[j] = key;
+            }
+            len = ext;
+        }
+        
+        // Merge pending runs whose boundary lies deeper than the new one
+        if (top > 0) {
+            int power = hydra_node_power(stack[top - 1].start, stack[top - 1].len, len, n);
+            while (top > 1 && stack[top - 2].power > power) {
+                HydraRun* l = &stack[top - 2];
+                HydraRun* r = &stack[top - 1];
+                hydra_merge_runs(arr, l->start, r->start, r->start + r->len, aux, aux_len);
+                l->len += r->len;
+                top--;
+            }
+            stack[top - 1].power = power;
+        }
+        
+        stack[top].start = start;
+        stack[top].len = len;
+        stack[top].power = 0;
+        top++;
+        start += len;
+    }
+    
+    // Collapse what is left, right to left
+    while (top > 1) {
+        HydraRun* l = &stack[top - 2];
+        HydraRun* r = &stack[top - 1];
+        hydra_merge_runs(arr, l->start, r->start, r->start + r->len, aux, aux_len);
+        l->len += r->len;
+        top--;
+    }
+}
+
+/**
+ * Powersort with a full buffer: aux must hold n elements
+ */
+HYDRA_RAMFUNC void hydra_powersort(int32_t* arr, size_t n, int32_t* aux) {
+    hydra_powersort_buffer(arr, n, aux, n);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INPUT ANALYSIS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Analyze input array to determine optimal algorithm
+ * Single O(n) pass collecting all statistics
+ */
+HYDRA_RAMFUNC HydraFeatures hydra_analyze(const int32_t* arr, size_t n) {
+    HydraFeatures f;
+    memset(&f, 0, sizeof(f));
+    f.n = n;
+    
+    if (n <= 1) {
+        f.presort = 255;
+        return f;
+    }
+    
+    int32_t min_val = arr[0];
+    int32_t max_val = arr[0];
+    size_t runs = 1;
+    size_t runs_desc = 1;
+    size_t dups = 0;
+    
+    for (size_t i = 1; i < n; i++) {
+        if (arr[i] < arr[i-1]) runs++;
+        if (arr[i] > arr[i-1]) runs_desc++;
+        dups += (arr[i] == arr[i-1]);
+        if (arr[i] < min_val) min_val = arr[i];
+        if (arr[i] > max_val) max_val = arr[i];
+    }
+    
+    f.min_val = min_val;
+    f.max_val = max_val;
+    
+    // Presortedness: 255 = fully sorted, 0 = maximally unsorted
+    f.presort = 255 - (uint8_t)((255ULL * (runs - 1)) / (n - 1));
+    f.runs = (runs < runs_desc) ? runs : runs_desc;
+    
+    // Low cardinality: with k keys in random order about 1/k of
+    // neighbours are equal
+    f.duplicates = (uint8_t)((255ULL * dups) / (n - 1));
+    
+    // Range in log2
+    uint32_t range = (uint32_t)max_val - (uint32_t)min_val;     // No signed overflow
+    f.range_log2 = (range > 0) ? hydra_log2(range) : 0;
+    
+    return f;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STRATEGY SELECTION
+// ═══════════════════════════════════════════════════════════════════════════
+
+// The M0+ has no branch predictor, so Lomuto's branch costs the same every
+// time there; hosts pay for mispredicts and default to block partitioning
+#if HYDRA_PLATFORM_PICO
+static HydraPartitionScheme hydra_partition_scheme = HYDRA_PARTITION_LOMUTO;
+#else
+static HydraPartitionScheme hydra_partition_scheme = HYDRA_PARTITION_BLOCK;
+#endif
+
+/**
+ * Select the partition used by introsort (for A/B comparisons)
+ */
+void hydra_set_partition_scheme(HydraPartitionScheme scheme) {
+    hydra_partition_scheme = scheme;
+}
+
+static size_t hydra_counting_budget = HYDRA_COUNTING_BUDGET;
+
+/**
+ * Largest histogram (in buckets, i.e. max - min + 1) the int32 counting
+ * sort may use; 0 disables it
+ */
+void hydra_set_counting_budget(size_t buckets) {
+    hydra_counting_budget = buckets;
+}
+
+/**
+ * Select optimal sorting strategy based on input features, allowing int32
+ * counting sort histograms of up to counting_budget buckets
+ */
+HYDRA_INLINE HydraStrategy hydra_select_stable(const HydraFeatures* f, size_t counting_budget);
+
+HYDRA_INLINE HydraStrategy hydra_select_strategy_budget(const HydraFeatures* f,
+                                                        HydraProfile profile,
+                                                        size_t counting_budget) {
+    HydraStrategy s = {ALG_NETWORK_4, false, false, 0};
+    size_t n = f->n;
+    
+    if (profile == HYDRA_PROFILE_STABLE) return hydra_select_stable(f, counting_budget);
+    
+    // Tiny arrays: direct network sort
+    if (n <= 4) {
+        s.algorithm = ALG_NETWORK_4;
+        return s;
+    }
+    if (n <= 8) {
+        s.algorithm = ALG_NETWORK_8;
+        return s;
     }
     if (n <= 16) {
         s.algorithm = ALG_NETWORK_16;
         return s;
     }
     
-    // Nearly sorted: insertion sort is O(n)
-    if (f->presort >= HYDRA_PRESORT_THRESHOLD) {
+    // Nearly sorted and small: insertion sort is O(n + inversions). Few
+    // breaks do not bound the inversions, though (one displaced key can
+    // cost n moves), so larger inputs go to powersort below
+    if (f->presort >= HYDRA_PRESORT_THRESHOLD && n <= HYDRA_INSERTION_PRESORT_MAX) {
         s.algorithm = ALG_INSERTION_SENTINEL;
         return s;
     }
@@ -569,15 +1631,47 @@ HYDRA_INLINE HydraStrategy hydra_select_strategy(const HydraFeatures* f,
         return s;
     }
     
+    // Few long runs (concatenated sorted streams, reversed input) or
+    // nearly sorted: merge the runs instead of discarding the order
+    if (f->presort >= HYDRA_PRESORT_THRESHOLD || f->runs * HYDRA_RUN_THRESHOLD <= n) {
+        s.algorithm = ALG_POWERSORT;
+        return s;
+    }
+    
+    // Range no wider than the input (and the budget): one counting pass,
+    // with the histogram in aux (or the radix table if it is small enough)
+    uint32_t range = (uint32_t)f->max_val - (uint32_t)f->min_val;
+    if (range < n && range < counting_budget) {
+        s.algorithm = ALG_COUNTING_I32;
+        return s;
+    }
+    
     // Check if radix sort is beneficial
-    // Radix wins when range is small relative to n
-    if (f->range_log2 <= hydra_log2(n) + 3) {  // range <= 8*n
+    // Radix wins when range is small relative to n, or fits in two digits
+    // (range-compressed: two passes regardless of where the values sit)
+    if (f->range_log2 <= hydra_log2(n) + 3 ||              // range <= 8*n
+        f->range_log2 + 1 <= 2 * HYDRA_RADIX_DIGIT_BITS) {
         if (n >= HYDRA_RADIX_THRESHOLD) {
             s.algorithm = ALG_RADIX_256;
+            s.use_parallel = n >= HYDRA_PARALLEL_RADIX_THRESHOLD;
             return s;
         }
     }
     
+    // Low cardinality: pdqsort drops each repeated pivot's keys in one
+    // pass, which beats splitting the work over two cores (any size)
+    if (f->duplicates >= HYDRA_DUPLICATE_THRESHOLD) {
+        s.algorithm = ALG_PDQSORT;
+        return s;
+    }
+    
+    // Medium random input: dual-pivot beats Lomuto introsort (fewer passes
+    // over the data) but loses to the branchless block partition
+    if (n <= HYDRA_BLOCK_SIZE && hydra_partition_scheme == HYDRA_PARTITION_LOMUTO) {
+        s.algorithm = ALG_QUICKSORT_DUAL_PIVOT;
+        return s;
+    }
+    
     // Large arrays: partition and parallel sort
     if (n > HYDRA_BLOCK_SIZE) {
         s.use_partitioning = true;
@@ -592,12 +1686,103 @@ HYDRA_INLINE HydraStrategy hydra_select_strategy(const HydraFeatures* f,
     return s;
 }
 
+/**
+ * HYDRA_PROFILE_STABLE selection: only engines that keep equal keys in
+ * input order. The adaptive rules stay, mapped onto stable engines:
+ * - small or nearly sorted and short: plain insertion sort
+ * - nearly sorted or few runs: powersort (stable merges; only strictly
+ *   descending runs are reversed)
+ * - range within n and the budget: counting sort (it rebuilds values
+ *   from counts, so there is no order to lose)
+ * - otherwise, from HYDRA_RADIX_THRESHOLD: LSD radix, parallel past
+ *   HYDRA_PARALLEL_RADIX_THRESHOLD (every pass is stable, per worker too)
+ * - below that: powersort
+ * Quicksorts, shell sort, heapsort, the networks and the in-place MSD
+ * radix are never chosen.
+ */
+HYDRA_INLINE HydraStrategy hydra_select_stable(const HydraFeatures* f, size_t counting_budget) {
+    HydraStrategy s = {ALG_POWERSORT, false, false, 0};
+    size_t n = f->n;
+    
+    if (n <= HYDRA_SHELL_THRESHOLD ||
+        (f->presort >= HYDRA_PRESORT_THRESHOLD && n <= HYDRA_INSERTION_PRESORT_MAX)) {
+        s.algorithm = ALG_INSERTION;
+        return s;
+    }
+    if (f->presort >= HYDRA_PRESORT_THRESHOLD || f->runs * HYDRA_RUN_THRESHOLD <= n) {
+        return s;
+    }
+    
+    uint32_t range = (uint32_t)f->max_val - (uint32_t)f->min_val;
+    if (range < n && range < counting_budget) {
+        s.algorithm = ALG_COUNTING_I32;
+        return s;
+    }
+    if (n >= HYDRA_RADIX_THRESHOLD) {
+        s.algorithm = ALG_RADIX_256;
+        s.use_parallel = n >= HYDRA_PARALLEL_RADIX_THRESHOLD;
+    }
+    return s;
+}
+
+/**
+ * Select optimal sorting strategy based on input features
+ */
+HYDRA_INLINE HydraStrategy hydra_select_strategy(const HydraFeatures* f,
+                                                   HydraProfile profile) {
+    return hydra_select_strategy_budget(f, profile, hydra_counting_budget);
+}
+
+/**
+ * Restrict a strategy to aux_len elements of aux (below n):
+ * - radix becomes the in-place American flag radix, and so does a
+ *   counting sort whose histogram fits neither the radix table nor aux
+ * - powersort stays while aux holds n/HYDRA_MERGE_BUFFER_DIV (merges
+ *   rotate past what does not fit); below that, rotations cost more than
+ *   pdqsort saves, so pdqsort
+ * - the parallel paths, which merge or scatter through a full aux,
+ *   become the serial per-block algorithm (introsort)
+ * With HYDRA_PROFILE_STABLE, radix and an unfitting counting sort become
+ * powersort instead, which merges through any aux_len (down to none).
+ */
+HYDRA_INLINE HydraStrategy hydra_strategy_fit(HydraStrategy s, const HydraFeatures* f,
+                                              size_t aux_len, HydraProfile profile) {
+    if (aux_len >= f->n) return s;
+    
+    HydraAlgorithm in_place = (profile == HYDRA_PROFILE_STABLE) ? ALG_POWERSORT : ALG_RADIX_INPLACE;
+    if (s.algorithm == ALG_RADIX_256) s.algorithm = in_place;
+    if (s.algorithm == ALG_COUNTING_I32) {
+        size_t buckets = (size_t)((uint32_t)f->max_val - (uint32_t)f->min_val) + 1;
+        if (buckets > HYDRA_RADIX_HIST_WORDS && buckets > aux_len) {
+            s.algorithm = in_place;
+        }
+    }
+    if (s.algorithm == ALG_POWERSORT && aux_len < f->n / HYDRA_MERGE_BUFFER_DIV &&
+        profile != HYDRA_PROFILE_STABLE) {
+        s.algorithm = ALG_PDQSORT;
+    }
+    s.use_partitioning = false;
+    s.use_parallel = false;
+    return s;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // INTROSORT (QUICK + HEAP FALLBACK)
 // ═══════════════════════════════════════════════════════════════════════════
 
 HYDRA_RAMFUNC void hydra_heapsort(int32_t* arr, size_t n);
 HYDRA_RAMFUNC size_t hydra_partition(int32_t* arr, size_t lo, size_t hi);
+HYDRA_RAMFUNC size_t hydra_partition_block(int32_t* arr, size_t lo, size_t hi);
+
+/**
+ * Partition arr[lo..hi] with the selected scheme, returning the pivot index
+ */
+HYDRA_INLINE size_t hydra_partition_selected(int32_t* arr, size_t lo, size_t hi) {
+    if (hydra_partition_scheme == HYDRA_PARTITION_BLOCK) {
+        return hydra_partition_block(arr, lo, hi);
+    }
+    return hydra_partition(arr, lo, hi);
+}
 
 /**
  * Introsort: Quicksort that falls back to heapsort on bad recursion
@@ -618,7 +1803,7 @@ HYDRA_RAMFUNC void hydra_introsort_impl(int32_t* arr, size_t lo, size_t hi, int
     }
     
     // Partition
-    size_t pivot = hydra_partition(arr, lo, hi);
+    size_t pivot = hydra_partition_selected(arr, lo, hi);
     
     // Recurse
     if (pivot > lo) {
@@ -666,6 +1851,125 @@ HYDRA_RAMFUNC size_t hydra_partition(int32_t* arr, size_t lo, size_t hi) {
     return i;
 }
 
+/**
+ * Branchless block partition (Edelkamp & Weiss, "BlockQuicksort")
+ *
+ * Scans a block from each end, recording the offsets of misplaced
+ * elements with an unconditional store and a 0/1 increment instead of a
+ * branch, then swaps the recorded pairs in one batch. The only
+ * data-dependent branches left are per block, not per element.
+ *
+ * Pivot is arr[lo], and some element of arr(lo..hi] must be >= pivot.
+ * On return arr[lo..p) < pivot <= arr(p..hi]; *already_partitioned is
+ * set when no element had to move.
+ */
+HYDRA_RAMFUNC size_t hydra_partition_right_block(int32_t* arr, size_t lo, size_t hi,
+                                                 bool* already_partitioned) {
+    int32_t pivot = arr[lo];
+    int32_t* begin = arr + lo;
+    int32_t* first = begin;
+    int32_t* last = arr + hi + 1;
+    
+    // First element >= pivot from the left, first element < pivot from the right
+    while (*++first < pivot);
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot));
+    } else {
+        while (!(*--last < pivot));
+    }
+    
+    *already_partitioned = first >= last;
+    if (first < last) {
+        int32_t t = *first; *first = *last; *last = t;
+        first++;
+        
+        uint8_t offsets_l[HYDRA_PARTITION_BLOCK_SIZE];
+        uint8_t offsets_r[HYDRA_PARTITION_BLOCK_SIZE];
+        int32_t* base_l = first;
+        int32_t* base_r = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+        
+        while (first < last) {
+            // Refill whichever side has run out of misplaced elements
+            size_t unknown = (size_t)(last - first);
+            size_t left_split = (num_l == 0) ? ((num_r == 0) ? unknown / 2 : unknown) : 0;
+            size_t right_split = (num_r == 0) ? (unknown - left_split) : 0;
+            if (left_split > HYDRA_PARTITION_BLOCK_SIZE) left_split = HYDRA_PARTITION_BLOCK_SIZE;
+            if (right_split > HYDRA_PARTITION_BLOCK_SIZE) right_split = HYDRA_PARTITION_BLOCK_SIZE;
+            
+            for (size_t i = 0; i < left_split; i++) {
+                offsets_l[num_l] = (uint8_t)i;
+                num_l += !(*first < pivot);
+                first++;
+            }
+            for (size_t i = 0; i < right_split; i++) {
+                offsets_r[num_r] = (uint8_t)(i + 1);
+                num_r += (*--last < pivot);
+            }
+            
+            // Swap matched pairs as a cyclic permutation (one temp, no swaps)
+            size_t num = (num_l < num_r) ? num_l : num_r;
+            if (num > 0) {
+                int32_t* l = base_l + offsets_l[start_l];
+                int32_t* r = base_r - offsets_r[start_r];
+                int32_t tmp = *l;
+                *l = *r;
+                for (size_t i = 1; i < num; i++) {
+                    l = base_l + offsets_l[start_l + i];
+                    *r = *l;
+                    r = base_r - offsets_r[start_r + i];
+                    *l = *r;
+                }
+                *r = tmp;
+            }
+            num_l -= num; num_r -= num;
+            start_l += num; start_r += num;
+            
+            if (num_l == 0) { start_l = 0; base_l = first; }
+            if (num_r == 0) { start_r = 0; base_r = last; }
+        }
+        
+        // One side still holds misplaced elements: move them to the boundary
+        if (num_l) {
+            while (num_l--) {
+                int32_t* l = base_l + offsets_l[start_l + num_l];
+                last--;
+                int32_t t2 = *l; *l = *last; *last = t2;
+            }
+            first = last;
+        }
+        if (num_r) {
+            while (num_r--) {
+                int32_t* r = base_r - offsets_r[start_r + num_r];
+                int32_t t2 = *r; *r = *first; *first = t2;
+                first++;
+            }
+        }
+    }
+    
+    // Put the pivot in place
+    int32_t* pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return (size_t)(pivot_pos - arr);
+}
+
+/**
+ * Block partition with median-of-three pivot (introsort's scheme)
+ */
+HYDRA_RAMFUNC size_t hydra_partition_block(int32_t* arr, size_t lo, size_t hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    bool already_partitioned;
+    
+    // Order arr[mid] <= arr[lo] <= arr[hi]: median at lo, and arr[hi]
+    // (>= pivot) stops the first left scan
+    if (arr[lo] < arr[mid]) { int32_t t = arr[lo]; arr[lo] = arr[mid]; arr[mid] = t; }
+    if (arr[hi] < arr[lo])  { int32_t t = arr[lo]; arr[lo] = arr[hi]; arr[hi] = t; }
+    if (arr[lo] < arr[mid]) { int32_t t = arr[lo]; arr[lo] = arr[mid]; arr[mid] = t; }
+    
+    return hydra_partition_right_block(arr, lo, hi, &already_partitioned);
+}
+
 /**
  * Heapsort (for introsort fallback)
  */
@@ -701,153 +2005,3127 @@ HYDRA_RAMFUNC void hydra_heapsort(int32_t* arr, size_t n) {
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// PARALLEL SORTING (DUAL-CORE)
+// DUAL-PIVOT QUICKSORT (YAROSLAVSKIY)
 // ═══════════════════════════════════════════════════════════════════════════
 
-// Shared state for core1
-static volatile bool core1_done = false;
-static int32_t* core1_arr = NULL;
-static size_t core1_n = 0;
-
-void hydra_core1_entry() {
-    // Sort our portion
-    hydra_introsort(core1_arr, core1_n);
-    core1_done = true;
-    
-    // Wait for more work or exit
-    while (1) {
-        uint32_t cmd = multicore_fifo_pop_blocking();
-        if (cmd == 0xDEAD) return;  // Exit signal
-        
-        core1_arr = (int32_t*)multicore_fifo_pop_blocking();
-        core1_n = multicore_fifo_pop_blocking();
-        core1_done = false;
-        
-        hydra_introsort(core1_arr, core1_n);
-        core1_done = true;
-    }
-}
-
 /**
- * Parallel block sort using both cores
+ * Dual-pivot quicksort: three-way split around p <= q per pass
+ *
+ * Each pass moves elements into [< p | p..q | > q], so the recursion is
+ * log3 rather than log2 deep and the array is streamed fewer times than
+ * with single-pivot partitioning. Pivots are the 2nd and 4th of five
+ * evenly spaced samples. Ranges of 16 or less go to the networks or
+ * insertion sort, and the depth limit falls back to heapsort.
  */
-void hydra_parallel_sort(int32_t* arr, size_t n, size_t block_size) {
-    size_t num_blocks = (n + block_size - 1) / block_size;
-    
-    // Launch core1
-    multicore_launch_core1(hydra_core1_entry);
+HYDRA_RAMFUNC void hydra_dual_pivot_impl(int32_t* arr, size_t lo, size_t hi, int depth) {
+    size_t n = hi - lo + 1;
     
-    // Distribute blocks: core0 gets even, core1 gets odd
-    for (size_t b = 0; b < num_blocks; b += 2) {
-        // Core0: block b
-        size_t start0 = b * block_size;
-        size_t len0 = (start0 + block_size <= n) ? block_size : (n - start0);
-        
-        // Core1: block b+1 (if exists)
-        if (b + 1 < num_blocks) {
-            size_t start1 = (b + 1) * block_size;
-            size_t len1 = (start1 + block_size <= n) ? block_size : (n - start1);
-            
-            // Launch core1 work
-            core1_arr = arr + start1;
-            core1_n = len1;
-            core1_done = false;
-        }
-        
-        // Core0 sorts its block
-        hydra_introsort(arr + start0, len0);
-        
-        // Wait for core1
-        if (b + 1 < num_blocks) {
-            while (!core1_done) {
-                tight_loop_contents();
-            }
-        }
+    // Base case: small array
+    if (n <= 16) {
+        hydra_sort_tiny(arr + lo, n);
+        return;
     }
     
-    // Signal core1 to exit
-    multicore_fifo_push_blocking(0xDEAD);
-}
-
-// ═══════════════════════════════════════════════════════════════════════════
+    // Depth limit reached: fall back to heapsort
+    if (depth == 0) {
+        hydra_heapsort(arr + lo, n);
+        return;
+    }
+    
+    // Five samples at sevenths, insertion-sorted in place
+    size_t seventh = n / 7;
+    size_t e3 = lo + n / 2;
+    size_t e[5] = {e3 - 2 * seventh, e3 - seventh, e3, e3 + seventh, e3 + 2 * seventh};
+    for (int i = 1; i < 5; i++) {
+        int32_t key = arr[e[i]];
+        int j = i;
+        while (j > 0 && arr[e[j - 1]] > key) {
+            arr[e[j]] = arr[e[j - 1]];
+            j--;
+        }
+        arr[e[j]] = key;
+    }
+    
+    // Pivots to the ends
+    int32_t p = arr[e[1]];
+    int32_t q = arr[e[3]];
+    arr[e[1]] = arr[lo];
+    arr[e[3]] = arr[hi];
+    
+    size_t lt = lo + 1;     // arr[lo+1 .. lt) < p
+    size_t gt = hi - 1;     // arr(gt .. hi-1] > q
+    
+    for (size_t k = lt; k <= gt; k++) {
+        int32_t x = arr[k];
+        if (x < p) {
+            arr[k] = arr[lt];
+            arr[lt++] = x;
+        } else if (x > q) {
+            while (arr[gt] > q && k < gt) gt--;
+            arr[k] = arr[gt];
+            arr[gt--] = x;
+            x = arr[k];
+            if (x < p) {
+                arr[k] = arr[lt];
+                arr[lt++] = x;
+            }
+        }
+    }
+    
+    // Pivots into their final slots
+    lt--;
+    gt++;
+    arr[lo] = arr[lt]; arr[lt] = p;
+    arr[hi] = arr[gt]; arr[gt] = q;
+    
+    if (lt > lo) hydra_dual_pivot_impl(arr, lo, lt - 1, depth - 1);
+    if (p < q && gt > lt + 1) hydra_dual_pivot_impl(arr, lt + 1, gt - 1, depth - 1);
+    if (gt < hi) hydra_dual_pivot_impl(arr, gt + 1, hi, depth - 1);
+}
+
+HYDRA_RAMFUNC void hydra_dual_pivot_sort(int32_t* arr, size_t n) {
+    if (n <= 1) return;
+    int depth = 2 * hydra_log2(n);
+    hydra_dual_pivot_impl(arr, 0, n - 1, depth);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PATTERN-DEFEATING QUICKSORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define HYDRA_PDQ_INSERTION     24      // Insertion sort below this size
+#define HYDRA_PDQ_NINTHER       128     // Ninther pivot above this size
+#define HYDRA_PDQ_PARTIAL_LIMIT 8       // Moves allowed by the partial insertion sort
+
+HYDRA_INLINE void hydra_swap_ptr(int32_t* a, int32_t* b) {
+    int32_t t = *a; *a = *b; *b = t;
+}
+
+// Order *a <= *b <= *c
+HYDRA_INLINE void hydra_sort3_ptr(int32_t* a, int32_t* b, int32_t* c) {
+    if (*b < *a) hydra_swap_ptr(a, b);
+    if (*c < *b) hydra_swap_ptr(b, c);
+    if (*b < *a) hydra_swap_ptr(a, b);
+}
+
+/**
+ * Hoare-style partition with the same contract as the block partition
+ * (one branch per element; used under HYDRA_PARTITION_LOMUTO)
+ */
+HYDRA_RAMFUNC size_t hydra_partition_right(int32_t* arr, size_t lo, size_t hi,
+                                           bool* already_partitioned) {
+    int32_t pivot = arr[lo];
+    int32_t* begin = arr + lo;
+    int32_t* first = begin;
+    int32_t* last = arr + hi + 1;
+    
+    while (*++first < pivot);
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot));
+    } else {
+        while (!(*--last < pivot));
+    }
+    
+    *already_partitioned = first >= last;
+    while (first < last) {
+        hydra_swap_ptr(first, last);
+        while (*++first < pivot);
+        while (!(*--last < pivot));
+    }
+    
+    int32_t* pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return (size_t)(pivot_pos - arr);
+}
+
+/**
+ * Partition arr[lo..hi] around arr[lo] with keys equal to the pivot on the
+ * left; returns the last index of the equal run
+ */
+HYDRA_RAMFUNC size_t hydra_partition_left(int32_t* arr, size_t lo, size_t hi) {
+    int32_t pivot = arr[lo];
+    int32_t* begin = arr + lo;
+    int32_t* first = begin;
+    int32_t* last = arr + hi + 1;
+    
+    while (pivot < *--last);
+    if (last + 1 == arr + hi + 1) {
+        while (first < last && !(pivot < *++first));
+    } else {
+        while (!(pivot < *++first));
+    }
+    
+    while (first < last) {
+        hydra_swap_ptr(first, last);
+        while (pivot < *--last);
+        while (!(pivot < *++first));
+    }
+    
+    *begin = *last;
+    *last = pivot;
+    return (size_t)(last - arr);
+}
+
+/**
+ * Insertion sort that gives up after HYDRA_PDQ_PARTIAL_LIMIT moves;
+ * returns true if arr[0..n) ended up sorted
+ */
+HYDRA_RAMFUNC bool hydra_partial_insertion(int32_t* arr, size_t n) {
+    size_t moves = 0;
+    
+    for (size_t i = 1; i < n; i++) {
+        int32_t key = arr[i];
+        size_t j = i;
+        while (j > 0 && arr[j - 1] > key) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = key;
+        moves += i - j;
+        if (moves > HYDRA_PDQ_PARTIAL_LIMIT) return false;
+    }
+    return true;
+}
+
+/**
+ * Pattern-defeating quicksort (Peters, "pdqsort")
+ *
+ * Introsort plus three defences against inputs that make it degrade:
+ *
+ * - Equal keys: when the pivot equals the element just left of the range
+ *   (the previous pivot), every key equal to it is partitioned to the
+ *   left and dropped in one step, so k distinct keys cost O(n log k).
+ * - Bad partitions: a split worse than 1/8 swaps a few elements to break
+ *   the pattern, and after log2(n) of them the range goes to heapsort.
+ * - Presorted ranges: if partitioning moved nothing, a bounded insertion
+ *   sort tries to finish both sides directly.
+ *
+ * The partition follows hydra_set_partition_scheme (block or branchy).
+ */
+HYDRA_RAMFUNC void hydra_pdqsort_impl(int32_t* arr, size_t lo, size_t hi,
+                                      int bad_allowed, bool leftmost) {
+    while (true) {
+        size_t n = hi - lo + 1;
+        
+        // Base case: small array
+        if (n < HYDRA_PDQ_INSERTION) {
+            hydra_insertion_small(arr + lo, n);
+            return;
+        }
+        
+        // Pivot to arr[lo]: median of three, or ninther for large ranges
+        int32_t* b = arr + lo;
+        int32_t* e = arr + hi;
+        size_t half = n / 2;
+        if (n > HYDRA_PDQ_NINTHER) {
+            hydra_sort3_ptr(b, b + half, e);
+            hydra_sort3_ptr(b + 1, b + half - 1, e - 1);
+            hydra_sort3_ptr(b + 2, b + half + 1, e - 2);
+            hydra_sort3_ptr(b + half - 1, b + half, b + half + 1);
+            hydra_swap_ptr(b, b + half);
+        } else {
+            hydra_sort3_ptr(b + half, b, e);
+        }
+        
+        // Pivot equals the previous pivot: nothing here is smaller, so
+        // skip every key equal to it
+        if (!leftmost && !(arr[lo - 1] < arr[lo])) {
+            lo = hydra_partition_left(arr, lo, hi) + 1;
+            if (lo > hi) return;
+            continue;
+        }
+        
+        bool already_partitioned;
+        size_t pivot = (hydra_partition_scheme == HYDRA_PARTITION_BLOCK)
+            ? hydra_partition_right_block(arr, lo, hi, &already_partitioned)
+            : hydra_partition_right(arr, lo, hi, &already_partitioned);
+        
+        size_t l_size = pivot - lo;
+        size_t r_size = hi - pivot;
+        
+        if (l_size < n / 8 || r_size < n / 8) {
+            // Bad split: give up after too many, otherwise break the pattern
+            if (--bad_allowed == 0) {
+                hydra_heapsort(arr + lo, n);
+                return;
+            }
+            int32_t* p = arr + pivot;
+            if (l_size >= HYDRA_PDQ_INSERTION) {
+                hydra_swap_ptr(b, b + l_size / 4);
+                hydra_swap_ptr(p - 1, p - l_size / 4);
+                if (l_size > HYDRA_PDQ_NINTHER) {
+                    hydra_swap_ptr(b + 1, b + (l_size / 4 + 1));
+                    hydra_swap_ptr(b + 2, b + (l_size / 4 + 2));
+                    hydra_swap_ptr(p - 2, p - (l_size / 4 + 1));
+                    hydra_swap_ptr(p - 3, p - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= HYDRA_PDQ_INSERTION) {
+                hydra_swap_ptr(p + 1, p + (1 + r_size / 4));
+                hydra_swap_ptr(e, e - r_size / 4 + 1);
+                if (r_size > HYDRA_PDQ_NINTHER) {
+                    hydra_swap_ptr(p + 2, p + (2 + r_size / 4));
+                    hydra_swap_ptr(p + 3, p + (3 + r_size / 4));
+                    hydra_swap_ptr(e - 1, e - r_size / 4);
+                    hydra_swap_ptr(e - 2, e - r_size / 4 - 1);
+                }
+            }
+        } else if (already_partitioned &&
+                   hydra_partial_insertion(arr + lo, l_size) &&
+                   hydra_partial_insertion(arr + pivot + 1, r_size)) {
+            // Nothing moved and both sides were (nearly) sorted
+            return;
+        }
+        
+        // Recurse left, loop on the right
+        if (l_size > 0) hydra_pdqsort_impl(arr, lo, pivot - 1, bad_allowed, leftmost);
+        if (r_size == 0) return;
+        lo = pivot + 1;
+        leftmost = false;
+    }
+}
+
+HYDRA_RAMFUNC void hydra_pdqsort(int32_t* arr, size_t n) {
+    if (n <= 1) return;
+    hydra_pdqsort_impl(arr, 0, n - 1, (int)hydra_log2(n), true);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORKER BACKEND
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * Every backend implements the same fork-join interface over a HydraWorkers
+ * set:
+ *
+ *   hydra_workers_start(w, n)      bring up the helper workers (n = 0: all)
+ *   hydra_workers_count(w)         workers available, the caller included
+ *   hydra_workers_run(w, fn, arg)  call fn(arg, i, workers) on every worker i
+ *                                  and return once all have finished; the
+ *                                  caller is i = 0
+ *   hydra_workers_stop(w)          shut the helpers down again
+ *
+ * plus HydraMutex (hydra_mutex_init / _enter / _exit / _destroy) for short
+ * critical sections between workers and hydra_spin_pause() for busy waits.
+ *
+ * hydra_workers_run queues one HydraJob per helper and runs slice 0 itself.
+ * Helpers stay parked on the queue between runs, so after hydra_init() the
+ * same workers serve every sort with no launch or teardown per call.
+ *
+ * hydra_backend_start / _workers / _run / _stop drive the default set used
+ * by hydra_sort and the other context-free entry points; every HydraContext
+ * owns a set of its own, so independent sorters never share a queue.
+ *
+ * The sorting code only ever sees worker indices, so the same block-sort and
+ * merge code runs on both RP2040 cores or on every core of a host.
+ */
+typedef void (*HydraWorkerFn)(void* arg, unsigned worker, unsigned workers);
+
+typedef struct {
+    HydraWorkerFn fn;
+    void* arg;
+    unsigned worker;
+    unsigned workers;
+    volatile bool done;
+} HydraJob;
+
+static unsigned hydra_requested_workers = 0;   // 0 = all available
+
+/**
+ * Monotonic microsecond clock (for parallel statistics and benchmarks)
+ */
+HYDRA_INLINE uint64_t hydra_clock_us(void) {
+#if HYDRA_PLATFORM_PICO
+    return time_us_64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+/**
+ * Limit parallel sections to n workers (0 restores the default: all cores)
+ *
+ * Takes effect at the next hydra_init(), or at the next parallel sort when
+ * the workers are not kept running.
+ */
+void hydra_set_workers(unsigned n) {
+    hydra_requested_workers = n;
+}
+
+#if HYDRA_BACKEND_PICO
+
+#define HYDRA_CORE1_EXIT  0xDEAD
+
+typedef struct {
+    unsigned workers;
+} HydraWorkers;
+
+// core1 serves one worker set at a time
+static bool hydra_core1_claimed = false;
+
+// One hardware spinlock, claimed on first use, backs every HydraMutex
+typedef struct {
+    int unused;
+} HydraMutex;
+
+static spin_lock_t* hydra_spinlock = NULL;
+
+HYDRA_INLINE void hydra_mutex_init(HydraMutex* m) {
+    (void)m;
+    if (!hydra_spinlock) {
+        hydra_spinlock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+    }
+}
+
+HYDRA_INLINE uint32_t hydra_mutex_enter(HydraMutex* m) {
+    (void)m;
+    return spin_lock_blocking(hydra_spinlock);
+}
+
+HYDRA_INLINE void hydra_mutex_exit(HydraMutex* m, uint32_t save) {
+    (void)m;
+    spin_unlock(hydra_spinlock, save);
+}
+
+HYDRA_INLINE void hydra_mutex_destroy(HydraMutex* m) {
+    (void)m;
+}
+
+HYDRA_INLINE void hydra_spin_pause(void) {
+    tight_loop_contents();
+}
+
+/**
+ * Core1 main loop: the SIO FIFO is the job queue, each word a HydraJob*
+ */
+void hydra_core1_entry() {
+    while (1) {
+        uint32_t word = multicore_fifo_pop_blocking();
+        if (word == HYDRA_CORE1_EXIT) return;  // Exit signal
+        
+        HydraJob* job = (HydraJob*)(uintptr_t)word;
+        job->fn(job->arg, job->worker, job->workers);
+        __atomic_store_n(&job->done, true, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * Start core1 for this set; if another set holds it, run on core0 alone
+ * (call from core0)
+ */
+void hydra_workers_start(HydraWorkers* w, unsigned requested) {
+    w->workers = 1;
+    if (requested != 1 && !hydra_core1_claimed) {
+        hydra_core1_claimed = true;
+        w->workers = 2;
+        multicore_reset_core1();
+        multicore_launch_core1(hydra_core1_entry);
+    }
+}
+
+HYDRA_INLINE unsigned hydra_workers_count(const HydraWorkers* w) {
+    return w->workers ? w->workers : 1;
+}
+
+void hydra_workers_run(HydraWorkers* w, HydraWorkerFn fn, void* arg) {
+    if (hydra_workers_count(w) == 1) {
+        fn(arg, 0, 1);
+        return;
+    }
+    
+    HydraJob job = {fn, arg, 1, 2, false};
+    multicore_fifo_push_blocking((uint32_t)(uintptr_t)&job);
+    
+    fn(arg, 0, 2);
+    
+    while (!__atomic_load_n(&job.done, __ATOMIC_ACQUIRE)) {
+        tight_loop_contents();
+    }
+}
+
+void hydra_workers_stop(HydraWorkers* w) {
+    if (w->workers == 2) {
+        multicore_fifo_push_blocking(HYDRA_CORE1_EXIT);
+        hydra_core1_claimed = false;
+    }
+    w->workers = 1;
+}
+
+#elif HYDRA_BACKEND_PTHREAD
+
+#define HYDRA_JOB_QUEUE_SIZE (2 * HYDRA_MAX_WORKERS)
+
+typedef struct {
+    pthread_mutex_t lock;
+} HydraMutex;
+
+HYDRA_INLINE void hydra_mutex_init(HydraMutex* m) {
+    pthread_mutex_init(&m->lock, NULL);
+}
+
+HYDRA_INLINE uint32_t hydra_mutex_enter(HydraMutex* m) {
+    pthread_mutex_lock(&m->lock);
+    return 0;
+}
+
+HYDRA_INLINE void hydra_mutex_exit(HydraMutex* m, uint32_t save) {
+    (void)save;
+    pthread_mutex_unlock(&m->lock);
+}
+
+HYDRA_INLINE void hydra_mutex_destroy(HydraMutex* m) {
+    pthread_mutex_destroy(&m->lock);
+}
+
+HYDRA_INLINE void hydra_spin_pause(void) {
+    sched_yield();
+}
+
+// Helper threads share one job ring; anyone waiting on a run helps drain it
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;      // A job was queued, or exit was requested
+    pthread_cond_t idle;      // A job finished or a queue slot freed up
+    pthread_t threads[HYDRA_MAX_WORKERS];
+    unsigned workers;
+    HydraJob* queue[HYDRA_JOB_QUEUE_SIZE];
+    unsigned head;
+    unsigned count;
+    bool exit;
+} HydraWorkers;
+
+// Pop and run one queued job; called and returns with the set's lock held
+static void hydra_pool_run_one(HydraWorkers* w) {
+    HydraJob* job = w->queue[w->head];
+    w->head = (w->head + 1) % HYDRA_JOB_QUEUE_SIZE;
+    w->count--;
+    pthread_cond_broadcast(&w->idle);
+    pthread_mutex_unlock(&w->lock);
+    
+    job->fn(job->arg, job->worker, job->workers);
+    
+    pthread_mutex_lock(&w->lock);
+    job->done = true;
+    pthread_cond_broadcast(&w->idle);
+}
+
+static void* hydra_pool_main(void* arg) {
+    HydraWorkers* w = (HydraWorkers*)arg;
+    
+    pthread_mutex_lock(&w->lock);
+    while (1) {
+        while (w->count == 0 && !w->exit) {
+            pthread_cond_wait(&w->wake, &w->lock);
+        }
+        if (w->count == 0) break;   // Exit once the queue is drained
+        hydra_pool_run_one(w);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+void hydra_workers_start(HydraWorkers* w, unsigned requested) {
+    unsigned workers = requested;
+    if (workers == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (cores > 0) ? (unsigned)cores : 1;
+    }
+    if (workers > HYDRA_MAX_WORKERS) workers = HYDRA_MAX_WORKERS;
+    
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->wake, NULL);
+    pthread_cond_init(&w->idle, NULL);
+    w->workers = workers;
+    w->head = 0;
+    w->count = 0;
+    w->exit = false;
+    
+    for (unsigned i = 1; i < workers; i++) {
+        if (pthread_create(&w->threads[i], NULL, hydra_pool_main, w) != 0) {
+            w->workers = i;   // Run with whatever we got
+            break;
+        }
+    }
+}
+
+HYDRA_INLINE unsigned hydra_workers_count(const HydraWorkers* w) {
+    return w->workers ? w->workers : 1;
+}
+
+void hydra_workers_run(HydraWorkers* w, HydraWorkerFn fn, void* arg) {
+    unsigned workers = hydra_workers_count(w);
+    if (workers == 1) {
+        fn(arg, 0, 1);
+        return;
+    }
+    
+    HydraJob jobs[HYDRA_MAX_WORKERS];
+    
+    pthread_mutex_lock(&w->lock);
+    for (unsigned i = 1; i < workers; i++) {
+        HydraJob* job = &jobs[i];
+        job->fn = fn;
+        job->arg = arg;
+        job->worker = i;
+        job->workers = workers;
+        job->done = false;
+        
+        while (w->count == HYDRA_JOB_QUEUE_SIZE) {
+            pthread_cond_wait(&w->idle, &w->lock);
+        }
+        w->queue[(w->head + w->count) % HYDRA_JOB_QUEUE_SIZE] = job;
+        w->count++;
+    }
+    pthread_cond_broadcast(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+    
+    fn(arg, 0, workers);
+    
+    // Wait for our slices, running queued jobs instead of sleeping
+    pthread_mutex_lock(&w->lock);
+    for (unsigned i = 1; i < workers; i++) {
+        while (!jobs[i].done) {
+            if (w->count > 0) {
+                hydra_pool_run_one(w);
+            } else {
+                pthread_cond_wait(&w->idle, &w->lock);
+            }
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+}
+
+void hydra_workers_stop(HydraWorkers* w) {
+    pthread_mutex_lock(&w->lock);
+    w->exit = true;
+    pthread_cond_broadcast(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+    
+    for (unsigned i = 1; i < w->workers; i++) {
+        pthread_join(w->threads[i], NULL);
+    }
+    w->workers = 1;
+    
+    pthread_cond_destroy(&w->idle);
+    pthread_cond_destroy(&w->wake);
+    pthread_mutex_destroy(&w->lock);
+}
+
+#else  // HYDRA_BACKEND_SERIAL
+
+typedef struct {
+    int unused;
+} HydraMutex;
+
+typedef struct {
+    int unused;
+} HydraWorkers;
+
+HYDRA_INLINE void hydra_mutex_init(HydraMutex* m) { (void)m; }
+HYDRA_INLINE uint32_t hydra_mutex_enter(HydraMutex* m) { (void)m; return 0; }
+HYDRA_INLINE void hydra_mutex_exit(HydraMutex* m, uint32_t save) { (void)m; (void)save; }
+HYDRA_INLINE void hydra_mutex_destroy(HydraMutex* m) { (void)m; }
+HYDRA_INLINE void hydra_spin_pause(void) {}
+
+void hydra_workers_start(HydraWorkers* w, unsigned requested) {
+    (void)w;
+    (void)requested;
+}
+
+HYDRA_INLINE unsigned hydra_workers_count(const HydraWorkers* w) {
+    (void)w;
+    return 1;
+}
+
+void hydra_workers_run(HydraWorkers* w, HydraWorkerFn fn, void* arg) {
+    (void)w;
+    fn(arg, 0, 1);
+}
+
+void hydra_workers_stop(HydraWorkers* w) {
+    (void)w;
+}
+
+#endif
+
+// The set behind hydra_init() and the context-free entry points
+static HydraWorkers hydra_default_workers;
+
+void hydra_backend_start(void) {
+    hydra_workers_start(&hydra_default_workers, hydra_requested_workers);
+}
+
+HYDRA_INLINE unsigned hydra_backend_workers(void) {
+    return hydra_workers_count(&hydra_default_workers);
+}
+
+void hydra_backend_run(HydraWorkerFn fn, void* arg) {
+    hydra_workers_run(&hydra_default_workers, fn, arg);
+}
+
+void hydra_backend_stop(void) {
+    hydra_workers_stop(&hydra_default_workers);
+}
+
+static bool hydra_workers_running = false;
+
+/**
+ * Start the worker backend once and keep it parked between sorts
+ *
+ * Optional: without it every parallel sort starts and stops its own
+ * workers. Call hydra_deinit() before handing core1 to other code.
+ */
+void hydra_init(void) {
+    if (hydra_workers_running) return;
+    hydra_backend_start();
+    hydra_workers_running = true;
+}
+
+/**
+ * Stop the workers started by hydra_init()
+ */
+void hydra_deinit(void) {
+    if (!hydra_workers_running) return;
+    hydra_backend_stop();
+    hydra_workers_running = false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARALLEL SORTING (MULTI-CORE)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Per-worker busy time for the block-sort phase of the last parallel sort
+ *
+ * Enable with hydra_set_parallel_stats(&stats). Utilisation is
+ * sum(busy_us) / (workers * wall_us).
+ */
+typedef struct {
+    unsigned workers;
+    uint64_t wall_us;                       // Block-sort phase, caller's view
+    uint64_t busy_us[HYDRA_MAX_WORKERS];    // Time spent sorting per worker
+    size_t ranges_shared;                   // Subranges handed to other workers
+} HydraParallelStats;
+
+static HydraParallelStats* hydra_parallel_stats = NULL;
+
+void hydra_set_parallel_stats(HydraParallelStats* stats) {
+    hydra_parallel_stats = stats;
+}
+
+typedef struct {
+    int32_t* arr;
+    size_t n;
+    int depth;
+} HydraRange;
+
+/**
+ * Shared work pool for the block-sort phase
+ *
+ * Workers claim blocks through a counter, so a worker that finishes early
+ * simply takes the next one. While someone is waiting, a worker
+ * partitioning a large range pushes one side onto a shared stack instead of
+ * recursing into it, so a slow block (heapsort fallback, skewed pivots) is
+ * finished by several workers and nobody idles behind it.
+ */
+typedef struct {
+    HydraMutex lock;
+    int32_t* arr;
+    size_t n;
+    size_t block_size;
+    size_t num_blocks;
+    size_t next_block;      // Next unclaimed block
+    HydraRange stack[HYDRA_TASK_STACK];
+    unsigned top;
+    size_t outstanding;     // Claimed blocks and stacked ranges not yet sorted
+    unsigned waiting;       // Workers with nothing to do
+    size_t shared;
+    HydraParallelStats* stats;
+} HydraRangePool;
+
+HYDRA_RAMFUNC void hydra_introsort_impl(int32_t* arr, size_t lo, size_t hi, int depth);
+
+/**
+ * Introsort one range, donating large subranges while workers wait
+ */
+static void hydra_pool_sort_range(HydraRangePool* pool, HydraRange r) {
+    while (r.n > HYDRA_SHARE_THRESHOLD && r.depth > 0 &&
+           __atomic_load_n(&pool->waiting, __ATOMIC_RELAXED) > 0) {
+        size_t p = hydra_partition_selected(r.arr, 0, r.n - 1);
+        HydraRange left = {r.arr, p, r.depth - 1};
+        HydraRange right = {r.arr + p + 1, r.n - p - 1, r.depth - 1};
+        
+        // Donate the smaller side, keep the larger one
+        HydraRange give = (left.n < right.n) ? left : right;
+        r = (left.n < right.n) ? right : left;
+        if (give.n <= 1) continue;
+        
+        uint32_t save = hydra_mutex_enter(&pool->lock);
+        bool pushed = pool->top < HYDRA_TASK_STACK;
+        if (pushed) {
+            pool->stack[pool->top++] = give;
+            pool->outstanding++;
+            pool->shared++;
+        }
+        hydra_mutex_exit(&pool->lock, save);
+        
+        if (!pushed) hydra_introsort_impl(give.arr, 0, give.n - 1, give.depth);
+    }
+    
+    if (r.n > 1) hydra_introsort_impl(r.arr, 0, r.n - 1, r.depth);
+}
+
+static void hydra_pool_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraRangePool* pool = (HydraRangePool*)arg;
+    uint64_t busy = 0;
+    bool is_waiting = false;
+    (void)workers;
+    
+    while (1) {
+        HydraRange r;
+        bool got = false, finished = false;
+        
+        uint32_t save = hydra_mutex_enter(&pool->lock);
+        if (pool->top > 0 || pool->next_block < pool->num_blocks) {
+            if (pool->top > 0) {
+                r = pool->stack[--pool->top];
+            } else {
+                size_t start = pool->next_block++ * pool->block_size;
+                r.arr = pool->arr + start;
+                r.n = (start + pool->block_size <= pool->n) ? pool->block_size : (pool->n - start);
+                r.depth = 2 * (int)hydra_log2((uint32_t)r.n);
+                pool->outstanding++;
+            }
+            got = true;
+            if (is_waiting) {
+                __atomic_store_n(&pool->waiting, pool->waiting - 1, __ATOMIC_RELAXED);
+                is_waiting = false;
+            }
+        } else if (pool->outstanding == 0) {
+            finished = true;
+            if (is_waiting) {
+                __atomic_store_n(&pool->waiting, pool->waiting - 1, __ATOMIC_RELAXED);
+                is_waiting = false;
+            }
+        } else if (!is_waiting) {
+            // Plain atomic stores (under the lock): the M0+ has no atomic RMW
+            __atomic_store_n(&pool->waiting, pool->waiting + 1, __ATOMIC_RELAXED);
+            is_waiting = true;
+        }
+        hydra_mutex_exit(&pool->lock, save);
+        
+        if (finished) break;
+        if (!got) {
+            hydra_spin_pause();
+            continue;
+        }
+        
+        uint64_t t0 = pool->stats ? hydra_clock_us() : 0;
+        hydra_pool_sort_range(pool, r);
+        if (pool->stats) busy += hydra_clock_us() - t0;
+        
+        save = hydra_mutex_enter(&pool->lock);
+        pool->outstanding--;
+        hydra_mutex_exit(&pool->lock, save);
+    }
+    
+    if (pool->stats) pool->stats->busy_us[worker] = busy;
+}
+
+typedef struct {
+    const int32_t* src;
+    int32_t* dst;
+    size_t n;
+    size_t run;
+} HydraMergeJob;
+
+static void hydra_merge_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraMergeJob* job = (HydraMergeJob*)arg;
+    hydra_merge_level(job->src, job->dst, job->n, job->run, worker, workers);
+}
+
+/**
+ * Parallel block sort + cascade merge on the running worker set w, with
+ * pool as the shared range pool and stats (or NULL) for the block phase
+ */
+void hydra_parallel_sort_on(HydraWorkers* w, HydraRangePool* pool, HydraParallelStats* stats,
+                            int32_t* arr, int32_t* aux, size_t n, size_t block_size) {
+    hydra_mutex_init(&pool->lock);
+    pool->arr = arr;
+    pool->n = n;
+    pool->block_size = block_size;
+    pool->num_blocks = (n + block_size - 1) / block_size;
+    pool->next_block = 0;
+    pool->top = 0;
+    pool->outstanding = 0;
+    pool->waiting = 0;
+    pool->shared = 0;
+    pool->stats = stats;
+    
+    uint64_t t0 = pool->stats ? hydra_clock_us() : 0;
+    hydra_workers_run(w, hydra_pool_worker, pool);
+    if (pool->stats) {
+        pool->stats->workers = hydra_workers_count(w);
+        pool->stats->wall_us = hydra_clock_us() - t0;
+        pool->stats->ranges_shared = pool->shared;
+    }
+    hydra_mutex_destroy(&pool->lock);
+    
+    // Cascade merge: all workers split every level
+    int32_t* src = arr;
+    int32_t* dst = aux;
+    
+    for (size_t run = block_size; run < n; run *= 4) {
+        HydraMergeJob merge = {src, dst, n, run};
+        hydra_workers_run(w, hydra_merge_worker, &merge);
+        
+        int32_t* temp = src; src = dst; dst = temp;
+    }
+    
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int32_t));
+    }
+}
+
+/**
+ * Parallel block sort + cascade merge on every backend worker
+ *
+ * Blocks are introsorted through a shared range pool (see HydraRangePool),
+ * then merged four at a time, ping-ponging between arr and aux. Every merge level is split by
+ * output rank so each worker produces one slice of every group. The
+ * result always ends up in arr.
+ */
+void hydra_parallel_sort(int32_t* arr, int32_t* aux, size_t n, size_t block_size) {
+    // Static: the shared stack is too big for a 4 KB core0 stack
+    static HydraRangePool pool;
+    
+    bool transient = !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    hydra_parallel_sort_on(&hydra_default_workers, &pool, hydra_parallel_stats,
+                           arr, aux, n, block_size);
+    if (transient) hydra_backend_stop();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARALLEL SAMPLE SORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+static HydraParallelMode hydra_parallel_mode = HYDRA_PARALLEL_MERGE;
+
+/**
+ * Choose how hydra_sort parallelises large arrays
+ */
+void hydra_set_parallel_mode(HydraParallelMode mode) {
+    hydra_parallel_mode = mode;
+}
+
+static void hydra_sort_limited(int32_t* arr, size_t n, int32_t* aux, size_t aux_len,
+                               HydraProfile profile, size_t counting_budget, uint32_t* hist);
+
+/*
+ * Buckets alternate between ranges and single values:
+ *
+ *   0: (-inf, s0)   1: == s0   2: (s0, s1)   3: == s1   ...   2k: (s[k-1], +inf)
+ *
+ * Splitters are deduplicated, so a key that fills a large part of the sample
+ * becomes a splitter and gets an equality bucket of its own. Equality
+ * buckets need no sorting, so a skewed key costs one copy instead of
+ * swamping one worker's range bucket.
+ */
+typedef struct {
+    int32_t* arr;
+    int32_t* aux;
+    size_t n;
+    HydraProfile profile;
+    size_t counting_budget;                     // For the bucket sorts
+    int32_t splitters[HYDRA_SAMPLE_BUCKETS - 1];
+    unsigned num_splitters;
+    unsigned num_buckets;                       // 2 * num_splitters + 1
+    size_t offsets[HYDRA_MAX_WORKERS][2 * HYDRA_SAMPLE_BUCKETS - 1];
+    size_t bucket_start[2 * HYDRA_SAMPLE_BUCKETS];
+    HydraMutex lock;
+    unsigned next_bucket;
+} HydraSampleJob;
+
+HYDRA_INLINE unsigned hydra_sample_classify(const HydraSampleJob* job, int32_t x) {
+    size_t j = hydra_lower_bound(job->splitters, job->num_splitters, x);
+    return (unsigned)(2 * j) + (j < job->num_splitters && job->splitters[j] == x);
+}
+
+// Phase 1: per-worker bucket histogram of one contiguous slice
+static void hydra_sample_count_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraSampleJob* job = (HydraSampleJob*)arg;
+    size_t lo = job->n * worker / workers;
+    size_t hi = job->n * (worker + 1) / workers;
+    size_t* counts = job->offsets[worker];
+    
+    memset(counts, 0, job->num_buckets * sizeof(size_t));
+    for (size_t i = lo; i < hi; i++) {
+        counts[hydra_sample_classify(job, job->arr[i])]++;
+    }
+}
+
+// Phase 2: scatter the slice into aux at this worker's disjoint offsets
+static void hydra_sample_scatter_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraSampleJob* job = (HydraSampleJob*)arg;
+    size_t lo = job->n * worker / workers;
+    size_t hi = job->n * (worker + 1) / workers;
+    size_t* offsets = job->offsets[worker];
+    
+    for (size_t i = lo; i < hi; i++) {
+        int32_t x = job->arr[i];
+        job->aux[offsets[hydra_sample_classify(job, x)]++] = x;
+    }
+}
+
+// Phase 3: claim buckets, sort range buckets in aux (arr as scratch), copy back
+static void hydra_sample_sort_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraSampleJob* job = (HydraSampleJob*)arg;
+    (void)worker;
+    (void)workers;
+    
+    while (1) {
+        uint32_t save = hydra_mutex_enter(&job->lock);
+        unsigned b = job->next_bucket++;
+        hydra_mutex_exit(&job->lock, save);
+        if (b >= job->num_buckets) break;
+        
+        size_t start = job->bucket_start[b];
+        size_t len = job->bucket_start[b + 1] - start;
+        if (len == 0) continue;
+        
+        if ((b & 1) == 0) {
+            hydra_sort_limited(job->aux + start, len, job->arr + start, len,
+                               job->profile, job->counting_budget, NULL);
+        }
+        memcpy(job->arr + start, job->aux + start, len * sizeof(int32_t));
+    }
+}
+
+/**
+ * Parallel sample sort on the running worker set w
+ *
+ * job and sample (HYDRA_SAMPLE_BUCKETS * HYDRA_SAMPLE_OVERSAMPLE entries)
+ * are the caller's scratch; buckets are sorted with counting_budget.
+ */
+void hydra_parallel_sample_sort_on(HydraWorkers* w, HydraSampleJob* job, int32_t* sample,
+                                   size_t counting_budget, int32_t* arr, int32_t* aux,
+                                   size_t n, HydraProfile profile) {
+    unsigned workers = hydra_workers_count(w);
+    
+    job->arr = arr;
+    job->aux = aux;
+    job->n = n;
+    job->profile = profile;
+    job->counting_budget = counting_budget;
+    
+    // Four range buckets per worker leaves room for dynamic balancing
+    unsigned ranges = 4 * workers;
+    if (ranges > HYDRA_SAMPLE_BUCKETS) ranges = HYDRA_SAMPLE_BUCKETS;
+    size_t sample_n = (size_t)ranges * HYDRA_SAMPLE_OVERSAMPLE;
+    if (sample_n > n) sample_n = n;
+    
+    // Random sample (xorshift), sorted to read off evenly spaced splitters
+    uint32_t rng = 0x9E3779B9u ^ (uint32_t)n;
+    for (size_t i = 0; i < sample_n; i++) {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        sample[i] = arr[rng % n];
+    }
+    hydra_introsort(sample, sample_n);
+    
+    job->num_splitters = 0;
+    for (unsigned r = 1; r < ranges; r++) {
+        int32_t s = sample[sample_n * r / ranges];
+        if (job->num_splitters == 0 || s != job->splitters[job->num_splitters - 1]) {
+            job->splitters[job->num_splitters++] = s;
+        }
+    }
+    job->num_buckets = 2 * job->num_splitters + 1;
+    
+    hydra_workers_run(w, hydra_sample_count_worker, job);
+    
+    // Exclusive prefix over (bucket, worker) turns counts into write offsets
+    size_t sum = 0;
+    for (unsigned b = 0; b < job->num_buckets; b++) {
+        job->bucket_start[b] = sum;
+        for (unsigned i = 0; i < workers; i++) {
+            size_t c = job->offsets[i][b];
+            job->offsets[i][b] = sum;
+            sum += c;
+        }
+    }
+    job->bucket_start[job->num_buckets] = sum;
+    
+    hydra_workers_run(w, hydra_sample_scatter_worker, job);
+    
+    hydra_mutex_init(&job->lock);
+    job->next_bucket = 0;
+    hydra_workers_run(w, hydra_sample_sort_worker, job);
+    hydra_mutex_destroy(&job->lock);
+}
+
+/**
+ * Parallel sample sort
+ *
+ * Splitters come from a sorted random sample. Every worker classifies its
+ * slice (count, then scatter into aux), so buckets hold disjoint value
+ * ranges and need no final merge. Workers then claim buckets and sort
+ * each one with the single-core strategy selector.
+ */
+void hydra_parallel_sample_sort(int32_t* arr, int32_t* aux, size_t n, HydraProfile profile) {
+    // Static: offsets alone are too big for a 4 KB core0 stack
+    static HydraSampleJob job;
+    static int32_t sample[HYDRA_SAMPLE_BUCKETS * HYDRA_SAMPLE_OVERSAMPLE];
+    
+    bool transient = !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    hydra_parallel_sample_sort_on(&hydra_default_workers, &job, sample, hydra_counting_budget,
+                                  arr, aux, n, profile);
+    if (transient) hydra_backend_stop();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARALLEL RADIX SORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * One LSD pass over W workers, each owning the slice [n*w/W, n*(w+1)/W):
+ *
+ *   count:   worker w builds the digit histogram of its slice
+ *   prefix:  offsets[w][d] = all elements with a smaller digit, plus
+ *            digit d from workers before w
+ *   scatter: every worker writes its slice to its own disjoint offsets
+ *
+ * Each worker scatters its slice in order and the workers' ranges per
+ * digit are ordered by worker, so every pass stays stable.
+ */
+typedef struct {
+    const int32_t* src;
+    int32_t* dst;
+    const uint16_t* src16;                      // u16 path when set
+    uint16_t* dst16;
+    const uint32_t* src_vals;                   // Payload moved with src when set
+    uint32_t* dst_vals;
+    size_t n;
+    uint32_t base;
+    int shift;
+    uint32_t mask;
+    uint32_t offsets[HYDRA_MAX_WORKERS][HYDRA_RADIX_BUCKETS];
+} HydraRadixJob;
+
+// Static: per-worker digit tables do not fit a core stack
+static HydraRadixJob hydra_radix_job;
+
+static void hydra_radix_count_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraRadixJob* job = (HydraRadixJob*)arg;
+    size_t lo = job->n * worker / workers;
+    size_t hi = job->n * (worker + 1) / workers;
+    uint32_t* counts = job->offsets[worker];
+    int shift = job->shift;
+    uint32_t mask = job->mask;
+    
+    memset(counts, 0, ((size_t)mask + 1) * sizeof(uint32_t));
+    if (job->src16) {
+        for (size_t i = lo; i < hi; i++) counts[(job->src16[i] >> shift) & mask]++;
+    } else {
+        uint32_t base = job->base;
+        for (size_t i = lo; i < hi; i++) counts[(((uint32_t)job->src[i] - base) >> shift) & mask]++;
+    }
+}
+
+static void hydra_radix_scatter_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraRadixJob* job = (HydraRadixJob*)arg;
+    size_t lo = job->n * worker / workers;
+    size_t hi = job->n * (worker + 1) / workers;
+    uint32_t* offsets = job->offsets[worker];
+    int shift = job->shift;
+    uint32_t mask = job->mask;
+    
+    if (job->src16) {
+        for (size_t i = lo; i < hi; i++) {
+            uint16_t x = job->src16[i];
+            job->dst16[offsets[(x >> shift) & mask]++] = x;
+        }
+        return;
+    }
+    
+    uint32_t base = job->base;
+    if (job->src_vals) {
+        for (size_t i = lo; i < hi; i++) {
+            int32_t x = job->src[i];
+            uint32_t slot = offsets[(((uint32_t)x - base) >> shift) & mask]++;
+            job->dst[slot] = x;
+            job->dst_vals[slot] = job->src_vals[i];
+        }
+        return;
+    }
+#if HYDRA_RADIX_WC
+    if (job->n >= hydra_radix_wc_threshold) {
+        hydra_scatter_wc((const uint32_t*)job->src + lo, (uint32_t*)job->dst, hi - lo,
+                         offsets, base, job->shift, mask);
+        return;
+    }
+#endif
+    for (size_t i = lo; i < hi; i++) {
+        int32_t x = job->src[i];
+        job->dst[offsets[(((uint32_t)x - base) >> shift) & mask]++] = x;
+    }
+}
+
+/**
+ * Run one pass across the workers; returns false (and moves nothing) if
+ * every element has the same digit
+ */
+static bool hydra_radix_parallel_pass(HydraWorkers* w, HydraRadixJob* job) {
+    unsigned workers = hydra_workers_count(w);
+    hydra_workers_run(w, hydra_radix_count_worker, job);
+    
+    // Exclusive prefix over (digit, worker)
+    uint32_t sum = 0;
+    for (uint32_t d = 0; d <= job->mask; d++) {
+        uint32_t digit_start = sum;
+        for (unsigned i = 0; i < workers; i++) {
+            uint32_t c = job->offsets[i][d];
+            job->offsets[i][d] = sum;
+            sum += c;
+        }
+        if (sum - digit_start == job->n) return false;
+    }
+    
+    hydra_workers_run(w, hydra_radix_scatter_worker, job);
+    return true;
+}
+
+/**
+ * Parallel radix of arr, moving vals[i] with arr[i] when vals is not NULL
+ * (aux_vals must then hold n as well)
+ */
+static void hydra_parallel_radix_kv_on(HydraWorkers* w, HydraRadixJob* job, int32_t* arr,
+                                       uint32_t* vals, int32_t* aux, uint32_t* aux_vals,
+                                       size_t n, int32_t min_val, uint8_t range_log2) {
+    int shifts[HYDRA_RADIX_DIGITS];
+    uint32_t masks[HYDRA_RADIX_DIGITS];
+    
+    if (n <= 1) return;
+    
+    int passes = hydra_radix_plan(range_log2, shifts, masks);
+    job->src = arr;
+    job->dst = aux;
+    job->src16 = NULL;
+    job->dst16 = NULL;
+    job->src_vals = vals;
+    job->dst_vals = aux_vals;
+    job->n = n;
+    job->base = (uint32_t)min_val;
+    
+    for (int pass = 0; pass < passes; pass++) {
+        job->shift = shifts[pass];
+        job->mask = masks[pass];
+        if (hydra_radix_parallel_pass(w, job)) {
+            int32_t* temp = (int32_t*)job->src;
+            job->src = job->dst;
+            job->dst = temp;
+            uint32_t* temp_vals = (uint32_t*)job->src_vals;
+            job->src_vals = job->dst_vals;
+            job->dst_vals = temp_vals;
+        }
+    }
+    
+    // Odd number of scatters: the result is in aux
+    if (job->src != arr) {
+        memcpy(arr, job->src, n * sizeof(int32_t));
+        if (vals) memcpy(vals, job->src_vals, n * sizeof(uint32_t));
+    }
+}
+
+/**
+ * hydra_parallel_radix_sort on the running worker set w, with job as the
+ * per-worker digit tables
+ */
+void hydra_parallel_radix_sort_on(HydraWorkers* w, HydraRadixJob* job, int32_t* arr,
+                                  int32_t* aux, size_t n, int32_t min_val, uint8_t range_log2) {
+    hydra_parallel_radix_kv_on(w, job, arr, NULL, aux, NULL, n, min_val, range_log2);
+}
+
+/**
+ * Parallel signed, range-compressed LSD radix sort
+ *
+ * Same digits as hydra_radix_sort_i32 (x - min_val over the fewest digits
+ * the range needs). Each pass counts, prefixes and scatters across all
+ * workers, with a fork-join between phases. aux must hold n.
+ */
+void hydra_parallel_radix_sort(int32_t* arr, int32_t* aux, size_t n,
+                               int32_t min_val, uint8_t range_log2) {
+    if (n <= 1) return;
+    
+    bool transient = !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    hydra_parallel_radix_sort_on(&hydra_default_workers, &hydra_radix_job,
+                                 arr, aux, n, min_val, range_log2);
+    if (transient) hydra_backend_stop();
+}
+
+/**
+ * Parallel two-pass radix sort for uint16_t arrays
+ */
+void hydra_parallel_counting_sort_u16(uint16_t* arr, uint16_t* aux, size_t n) {
+    HydraRadixJob* job = &hydra_radix_job;
+    
+    if (n <= 1) return;
+    
+    bool transient = !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    
+    job->src = NULL;
+    job->dst = NULL;
+    job->src16 = arr;
+    job->dst16 = aux;
+    job->src_vals = NULL;
+    job->dst_vals = NULL;
+    job->n = n;
+    job->mask = 0xFF;
+    
+    for (int byte = 0; byte < 2; byte++) {
+        job->shift = byte * 8;
+        if (hydra_radix_parallel_pass(&hydra_default_workers, job)) {
+            uint16_t* temp = (uint16_t*)job->src16;
+            job->src16 = job->dst16;
+            job->dst16 = temp;
+        }
+    }
+    
+    if (job->src16 != arr) memcpy(arr, job->src16, n * sizeof(uint16_t));
+    
+    if (transient) hydra_backend_stop();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
 // MAIN ENTRY POINT
 // ═══════════════════════════════════════════════════════════════════════════
 
 /**
- * HYDRA-SORT v2.0 MAXIMUM OVERDRIVE
- * 
- * The ultimate sorting function for RP2040
- * 
- * @param arr       Array to sort (in-place)
- * @param n         Number of elements
- * @param aux       Auxiliary buffer (size n, required for some algorithms)
- * @param profile   Performance profile
+ * Run one selected algorithm over the whole array; hist is a
+ * HYDRA_RADIX_HIST_WORDS digit table, or NULL for this core's own
+ */
+static void hydra_run_algorithm(HydraAlgorithm algorithm, const HydraFeatures* f,
+                                int32_t* arr, size_t n, int32_t* aux, size_t aux_len,
+                                uint32_t* hist) {
+    switch (algorithm) {
+        case ALG_NETWORK_4:
+        case ALG_NETWORK_8:
+        case ALG_NETWORK_16:
+            hydra_sort_tiny(arr, n);
+            break;
+        case ALG_INSERTION_SENTINEL:
+            hydra_insertion_sentinel(arr, n);
+            break;
+        case ALG_INSERTION:
+            hydra_insertion_small(arr, n);
+            break;
+        case ALG_SHELL_CIURA:
+            hydra_shell_sort(arr, n);
+            break;
+        case ALG_RADIX_256:
+            if (hist) {
+                hydra_radix_sort_i32_hist(arr, aux, n, f->min_val, f->range_log2, hist);
+            } else {
+                hydra_radix_sort_i32(arr, aux, n, f->min_val, f->range_log2);
+            }
+            break;
+        case ALG_COUNTING_I32: {
+            // Histogram in the radix table if it fits, else in aux
+            uint32_t buckets = (uint32_t)f->max_val - (uint32_t)f->min_val + 1;
+            uint32_t* counts = (buckets <= HYDRA_RADIX_HIST_WORDS) ? hist : (uint32_t*)aux;
+            hydra_counting_sort_i32(arr, n, f->min_val, f->max_val, counts);
+            break;
+        }
+        case ALG_RADIX_INPLACE:
+            if (hist) {
+                hydra_flag_sort_impl(arr, n, (uint32_t)f->min_val, f->range_log2 + 1, hist);
+            } else {
+                hydra_american_flag_sort(arr, n, f->min_val, f->range_log2);
+            }
+            break;
+        case ALG_QUICKSORT_DUAL_PIVOT:
+            hydra_dual_pivot_sort(arr, n);
+            break;
+        case ALG_PDQSORT:
+            hydra_pdqsort(arr, n);
+            break;
+        case ALG_POWERSORT:
+            hydra_powersort_buffer(arr, n, aux, aux_len);
+            break;
+        case ALG_INTROSORT:
+        default:
+            hydra_introsort(arr, n);
+            break;
+    }
+}
+
+/**
+ * Single-core sort with aux_len elements of aux (any amount, including 0)
+ */
+static void hydra_sort_limited(int32_t* arr, size_t n, int32_t* aux, size_t aux_len,
+                               HydraProfile profile, size_t counting_budget, uint32_t* hist) {
+    if (n <= 1) return;
+    
+    // Tiny arrays: networks for exact sizes, otherwise insertion sort
+    // (the networks always touch 4/8/16 elements; stable mode skips them)
+    if (n <= 16) {
+        if (profile == HYDRA_PROFILE_STABLE) hydra_insertion_small(arr, n);
+        else hydra_sort_tiny(arr, n);
+        return;
+    }
+    
+    HydraFeatures features = hydra_analyze(arr, n);
+    HydraStrategy strategy = hydra_select_strategy_budget(&features, profile, counting_budget);
+    strategy = hydra_strategy_fit(strategy, &features, aux_len, profile);
+    hydra_run_algorithm(strategy.algorithm, &features, arr, n, aux, aux_len, hist);
+}
+
+/**
+ * Single-core sort: analysis and strategy selection, but never the
+ * parallel path (large inputs get the per-block algorithm, introsort)
+ */
+void hydra_sort_serial(int32_t* arr, size_t n, int32_t* aux, HydraProfile profile) {
+    hydra_sort_limited(arr, n, aux, aux ? n : 0, profile, hydra_counting_budget, NULL);
+}
+
+/**
+ * HYDRA-SORT v2.0 MAXIMUM OVERDRIVE
+ * 
+ * The ultimate sorting function for RP2040
+ * 
+ * @param arr       Array to sort (in-place)
+ * @param n         Number of elements
+ * @param aux       Auxiliary buffer (size n), or NULL to sort in place
+ * @param profile   Performance profile
+ */
+void hydra_sort(int32_t* arr, size_t n, int32_t* aux, HydraProfile profile) {
+    if (n <= 1) return;
+    
+    // Tiny arrays: networks for exact sizes, otherwise insertion sort
+    // (the networks always touch 4/8/16 elements; stable mode skips them)
+    if (n <= 16) {
+        if (profile == HYDRA_PROFILE_STABLE) hydra_insertion_small(arr, n);
+        else hydra_sort_tiny(arr, n);
+        return;
+    }
+    
+    // Analyze input
+    HydraFeatures features = hydra_analyze(arr, n);
+    
+    // Select strategy
+    HydraStrategy strategy = hydra_select_strategy(&features, profile);
+    strategy = hydra_strategy_fit(strategy, &features, aux ? n : 0, profile);
+    
+    // Execute
+    if (strategy.use_partitioning && strategy.use_parallel) {
+        if (hydra_parallel_mode == HYDRA_PARALLEL_SAMPLE) {
+            // Large array: sample sort into disjoint buckets
+            hydra_parallel_sample_sort(arr, aux, n, profile);
+        } else {
+            // Large array: parallel block sort + cascade merge
+            hydra_parallel_sort(arr, aux, n, strategy.block_size);
+        }
+    } else if (strategy.use_parallel && strategy.algorithm == ALG_RADIX_256) {
+        // Large small-range array: every radix pass split over the workers
+        hydra_parallel_radix_sort(arr, aux, n, features.min_val, features.range_log2);
+    } else {
+        // Single algorithm execution
+        hydra_run_algorithm(strategy.algorithm, &features, arr, n, aux, aux ? n : 0, NULL);
+    }
+}
+
+/**
+ * Sort within a caller-sized workspace
+ *
+ * With room for n int32 this is hydra_sort. Below that, only algorithms
+ * that fit are chosen: in-place radix, counting sort with the histogram in
+ * the workspace, pdqsort/introsort, and powersort merging through however
+ * much workspace there is. workspace may be NULL when workspace_bytes is 0,
+ * and must be int32-aligned otherwise; nothing past workspace_bytes is
+ * touched.
+ */
+void hydra_sort_workspace(int32_t* arr, size_t n, void* workspace, size_t workspace_bytes,
+                          HydraProfile profile) {
+    size_t aux_len = workspace ? workspace_bytes / sizeof(int32_t) : 0;
+    if (aux_len >= n) {
+        hydra_sort(arr, n, (int32_t*)workspace, profile);
+    } else {
+        hydra_sort_limited(arr, n, (int32_t*)workspace, aux_len, profile,
+                           hydra_counting_budget, NULL);
+    }
+}
+
+/**
+ * Specialized version for uint8_t (NUCLEAR OPTION)
+ * Up to 30x+ faster than comparison sorts
+ */
+void hydra_sort_u8(uint8_t* arr, size_t n) {
+    hydra_counting_sort_u8(arr, n);
+}
+
+/**
+ * Specialized version for uint16_t
+ * Up to 5x+ faster than comparison sorts; aux may be NULL (in-place MSD)
+ */
+void hydra_sort_u16(uint16_t* arr, uint16_t* aux, size_t n) {
+    if (!aux) {
+        hydra_american_flag_sort_u16(arr, n);
+    } else if (n >= HYDRA_PARALLEL_RADIX_THRESHOLD) {
+        hydra_parallel_counting_sort_u16(arr, aux, n);
+    } else {
+        hydra_counting_sort_u16(arr, aux, n);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SORTING CONTEXT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Everything one sorter needs, owned by the caller
+ *
+ * The aux buffer, the digit table, the scratch of every parallel path, a
+ * worker set and the tuning all live in the context, so hydra_context_sort
+ * allocates nothing and independent contexts can sort at the same time
+ * (one per thread, or one in an interrupt handler and one in the main
+ * loop). Two global settings still apply to every context, read at each
+ * sort: the partition scheme (hydra_set_partition_scheme) and the
+ * write-combining threshold (hydra_set_radix_wc_threshold). Set them
+ * before contexts start sorting. The RP2040 has one core1, so only the
+ * first started context gets it; the others sort on their caller's core.
+ *
+ * The tables make a context large (about 15 KB on the RP2040, more on
+ * hosts with per-worker digit tables for HYDRA_MAX_WORKERS); keep it
+ * static or on the heap, never on a stack.
+ */
+typedef struct {
+    int32_t* aux;
+    size_t aux_len;
+    
+    // Tuning: hydra_context_init copies the global settings
+    HydraParallelMode parallel_mode;
+    size_t counting_budget;
+    unsigned requested_workers;
+    HydraParallelStats* stats;
+    
+    // Declared key range (hydra_context_set_range)
+    bool range_known;
+    int32_t min_val;
+    int32_t max_val;
+    
+    HydraWorkers workers;
+    bool running;
+    
+    uint32_t hist[HYDRA_RADIX_HIST_WORDS];
+    HydraRangePool range_pool;
+    HydraSampleJob sample_job;
+    int32_t sample[HYDRA_SAMPLE_BUCKETS * HYDRA_SAMPLE_OVERSAMPLE];
+    HydraRadixJob radix_job;
+} HydraContext;
+
+/**
+ * Set up a context sorting through aux_len elements of aux
+ *
+ * aux may be NULL (with aux_len 0); with fewer than n elements a sort
+ * picks what fits, as hydra_sort_workspace does. Workers, parallel mode
+ * and counting budget start from the current global settings.
+ */
+void hydra_context_init(HydraContext* ctx, int32_t* aux, size_t aux_len) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->aux = aux;
+    ctx->aux_len = aux ? aux_len : 0;
+    ctx->parallel_mode = hydra_parallel_mode;
+    ctx->counting_budget = hydra_counting_budget;
+    ctx->requested_workers = hydra_requested_workers;
+}
+
+/**
+ * Limit this context's parallel sections to n workers (0 = all cores);
+ * takes effect at the next hydra_context_start
+ */
+void hydra_context_set_workers(HydraContext* ctx, unsigned n) {
+    ctx->requested_workers = n;
+}
+
+void hydra_context_set_parallel_mode(HydraContext* ctx, HydraParallelMode mode) {
+    ctx->parallel_mode = mode;
+}
+
+void hydra_context_set_counting_budget(HydraContext* ctx, size_t buckets) {
+    ctx->counting_budget = buckets;
+}
+
+void hydra_context_set_parallel_stats(HydraContext* ctx, HydraParallelStats* stats) {
+    ctx->stats = stats;
+}
+
+/**
+ * Declare that every key sorted through ctx lies in [min_val, max_val]
+ *
+ * For inputs with a fixed range (ADC frames, 12-bit sensor codes): when
+ * that range selects counting sort or radix, sorts skip the analysis pass
+ * (and with it the check for presorted input). Keys outside the range are
+ * undefined behaviour. min_val > max_val forgets the range again.
+ */
+void hydra_context_set_range(HydraContext* ctx, int32_t min_val, int32_t max_val) {
+    ctx->range_known = min_val <= max_val;
+    ctx->min_val = min_val;
+    ctx->max_val = max_val;
+}
+
+/**
+ * Start this context's workers and keep them parked between sorts
+ */
+void hydra_context_start(HydraContext* ctx) {
+    if (ctx->running) return;
+    hydra_workers_start(&ctx->workers, ctx->requested_workers);
+    ctx->running = true;
+}
+
+/**
+ * Stop the workers started by hydra_context_start
+ */
+void hydra_context_stop(HydraContext* ctx) {
+    if (!ctx->running) return;
+    hydra_workers_stop(&ctx->workers);
+    ctx->running = false;
+}
+
+/**
+ * hydra_sort through a context
+ *
+ * Same selection and algorithms as hydra_sort, with the context's buffers,
+ * workers and tuning. Parallel paths start and stop the context's workers
+ * around the sort unless hydra_context_start has been called.
+ */
+void hydra_context_sort(HydraContext* ctx, int32_t* arr, size_t n, HydraProfile profile) {
+    if (n <= 1) return;
+    if (n <= 16) {
+        if (profile == HYDRA_PROFILE_STABLE) hydra_insertion_small(arr, n);
+        else hydra_sort_tiny(arr, n);
+        return;
+    }
+    
+    HydraFeatures features;
+    HydraStrategy strategy;
+    bool from_range = false;
+    
+    if (ctx->range_known) {
+        // Only the fields the counting and radix rules read
+        uint32_t range = (uint32_t)ctx->max_val - (uint32_t)ctx->min_val;
+        memset(&features, 0, sizeof(features));
+        features.n = n;
+        features.runs = n;
+        features.min_val = ctx->min_val;
+        features.max_val = ctx->max_val;
+        features.range_log2 = (range > 0) ? hydra_log2(range) : 0;
+        strategy = hydra_select_strategy_budget(&features, profile, ctx->counting_budget);
+        from_range = strategy.algorithm == ALG_COUNTING_I32 || strategy.algorithm == ALG_RADIX_256;
+    }
+    if (!from_range) {
+        features = hydra_analyze(arr, n);
+        strategy = hydra_select_strategy_budget(&features, profile, ctx->counting_budget);
+    }
+    strategy = hydra_strategy_fit(strategy, &features, ctx->aux_len, profile);
+    
+    if (!strategy.use_parallel) {
+        hydra_run_algorithm(strategy.algorithm, &features, arr, n, ctx->aux, ctx->aux_len,
+                            ctx->hist);
+        return;
+    }
+    
+    bool transient = !ctx->running;
+    if (transient) hydra_context_start(ctx);
+    
+    if (strategy.use_partitioning) {
+        if (ctx->parallel_mode == HYDRA_PARALLEL_SAMPLE) {
+            hydra_parallel_sample_sort_on(&ctx->workers, &ctx->sample_job, ctx->sample,
+                                          ctx->counting_budget, arr, ctx->aux, n, profile);
+        } else {
+            hydra_parallel_sort_on(&ctx->workers, &ctx->range_pool, ctx->stats,
+                                   arr, ctx->aux, n, strategy.block_size);
+        }
+    } else {
+        hydra_parallel_radix_sort_on(&ctx->workers, &ctx->radix_job, arr, ctx->aux, n,
+                                     features.min_val, features.range_log2);
+    }
+    
+    if (transient) hydra_context_stop(ctx);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BATCHED SMALL ARRAYS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * Many small independent arrays in one call (per-packet feature vectors,
+ * sensor windows). Each array is sorted by its length alone: no analysis
+ * and no strategy selection.
+ *
+ * On hosts, arrays are grouped by power-of-two size class (8 ..
+ * HYDRA_BATCH_MAX) as they are scanned, and each full group of
+ * HYDRA_BATCH_LANES is sorted together: element j of every array goes into
+ * vector row j (short arrays padded with INT32_MAX), and Batcher's
+ * odd-even merge network runs over the rows, each comparator one vector
+ * compare-exchange across all lanes. Arrays of exactly 4, 8 or 16 sort
+ * faster in the register networks than they transpose, and go there. The
+ * RP2040 sorts one array at a time with the register networks, insertion
+ * and shell sort.
+ *
+ * Large batches are split into chunks of HYDRA_BATCH_CHUNK arrays that the
+ * workers claim as they go, so a few long arrays do not stall the rest.
+ */
+typedef struct {
+    const HydraSlice* items;    // Pointer list, or
+    const size_t* offsets;      // CSR segments (count + 1 offsets into base), or
+    int32_t* base;              // neither: count arrays of n, stride apart
+    int32_t* aux;               // Segment scratch at base's offsets, or NULL
+    size_t n;
+    size_t stride;
+    size_t count;
+    size_t skip;                // Arrays this long or longer are sorted elsewhere
+    HydraProfile profile;
+    HydraMutex lock;
+    size_t next;                // First unclaimed array
+} HydraBatchJob;
+
+HYDRA_INLINE void hydra_batch_item(const HydraBatchJob* job, size_t i, int32_t** arr, size_t* n) {
+    if (job->items) {
+        *arr = job->items[i].arr;
+        *n = job->items[i].n;
+    } else if (job->offsets) {
+        *arr = job->base + job->offsets[i];
+        *n = job->offsets[i + 1] - job->offsets[i];
+    } else {
+        *arr = job->base + i * job->stride;
+        *n = job->n;
+    }
+}
+
+// One array on its own (RP2040, arrays past the networks)
+HYDRA_INLINE void hydra_batch_scalar(const HydraBatchJob* job, int32_t* arr, size_t n) {
+    if (n <= HYDRA_SMALL_THRESHOLD) {
+        hydra_sort_tiny(arr, n);
+    } else if (n <= HYDRA_SHELL_THRESHOLD) {
+        hydra_shell_sort(arr, n);
+    } else {
+        int32_t* aux = job->aux ? job->aux + (arr - job->base) : NULL;
+        hydra_sort_serial(arr, n, aux, job->profile);
+    }
+}
+
+// End of the next claim: HYDRA_BATCH_CHUNK arrays, or for segments about
+// HYDRA_SEGMENT_CHUNK elements (at least one segment)
+HYDRA_INLINE size_t hydra_batch_claim_end(const HydraBatchJob* job, size_t lo) {
+    if (!job->offsets) {
+        return (lo + HYDRA_BATCH_CHUNK < job->count) ? lo + HYDRA_BATCH_CHUNK : job->count;
+    }
+    size_t target = job->offsets[lo] + HYDRA_SEGMENT_CHUNK;
+    size_t first = lo + 1, last = job->count;
+    while (first < last) {
+        size_t mid = first + (last - first) / 2;
+        if (job->offsets[mid] < target) first = mid + 1;
+        else last = mid;
+    }
+    return first;
+}
+
+#if HYDRA_BATCH_SIMD
+typedef int32_t HydraLanes __attribute__((vector_size(HYDRA_BATCH_LANES * sizeof(int32_t))));
+
+#define HYDRA_BATCH_CLASSES     6       // Rows 2 << class, up to HYDRA_BATCH_MAX
+
+/**
+ * Batcher's odd-even merge sort over rows (a power of two) vectors, every
+ * lane an independent array; same comparators as hydra_sort4/8/16
+ *
+ * Rows from used on hold INT32_MAX in every lane, so a comparator that
+ * reaches one never swaps and is skipped.
+ */
+HYDRA_INLINE void hydra_lanes_network(HydraLanes* v, unsigned rows, unsigned used) {
+    for (unsigned p = 1; p < rows; p <<= 1) {
+        for (unsigned k = p; k >= 1; k >>= 1) {
+            for (unsigned j = k % p; j + k < used; j += 2 * k) {
+                for (unsigned i = 0; i < k && i + j + k < used; i++) {
+                    if ((i + j) / (2 * p) != (i + j + k) / (2 * p)) continue;
+                    HydraLanes a = v[i + j];
+                    HydraLanes b = v[i + j + k];
+                    HydraLanes flip = (a ^ b) & (HydraLanes)(a > b);
+                    v[i + j] = a ^ flip;
+                    v[i + j + k] = b ^ flip;
+                }
+            }
+        }
+    }
+}
+
+// Sort up to HYDRA_BATCH_LANES arrays of at most rows elements together
+HYDRA_INLINE void hydra_batch_lanes_rows(int32_t* const* arrs, const size_t* ns, unsigned lanes,
+                                         unsigned rows) {
+    HydraLanes v[HYDRA_BATCH_MAX];
+    HydraLanes pad = {0};
+    unsigned used = 0;
+    
+    pad += INT32_MAX;
+    for (unsigned l = 0; l < lanes; l++) {
+        if (ns[l] > used) used = (unsigned)ns[l];
+    }
+    for (unsigned j = 0; j < used; j++) v[j] = pad;
+    for (unsigned l = 0; l < lanes; l++) {
+        for (unsigned j = 0; j < ns[l]; j++) v[j][l] = arrs[l][j];
+    }
+    hydra_lanes_network(v, rows, used);
+    for (unsigned l = 0; l < lanes; l++) {
+        for (unsigned j = 0; j < ns[l]; j++) arrs[l][j] = v[j][l];
+    }
+}
+
+/**
+ * Sort up to HYDRA_BATCH_LANES arrays of at most rows (8 .. HYDRA_BATCH_MAX,
+ * a power of two) elements together; one unrolled network per size
+ */
+HYDRA_RAMFUNC void hydra_batch_lanes(int32_t* const* arrs, const size_t* ns, unsigned lanes,
+                                     unsigned rows) {
+    switch (rows) {
+        case 8:  hydra_batch_lanes_rows(arrs, ns, lanes, 8); break;
+        case 16: hydra_batch_lanes_rows(arrs, ns, lanes, 16); break;
+        case 32: hydra_batch_lanes_rows(arrs, ns, lanes, 32); break;
+        default: hydra_batch_lanes_rows(arrs, ns, lanes, HYDRA_BATCH_MAX); break;
+    }
+}
+#endif
+
+static void hydra_batch_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraBatchJob* job = (HydraBatchJob*)arg;
+#if HYDRA_BATCH_SIMD
+    // Arrays waiting for a full group, per size class
+    int32_t* pending[HYDRA_BATCH_CLASSES][HYDRA_BATCH_LANES];
+    size_t pending_n[HYDRA_BATCH_CLASSES][HYDRA_BATCH_LANES];
+    unsigned waiting[HYDRA_BATCH_CLASSES] = {0};
+#endif
+    (void)worker;
+    (void)workers;
+    
+    while (1) {
+        uint32_t save = hydra_mutex_enter(&job->lock);
+        size_t lo = job->next;
+        if (lo < job->count) job->next = hydra_batch_claim_end(job, lo);
+        size_t hi = job->next;
+        hydra_mutex_exit(&job->lock, save);
+        if (lo >= hi) break;
+        
+        for (size_t i = lo; i < hi; i++) {
+            int32_t* arr;
+            size_t n;
+            hydra_batch_item(job, i, &arr, &n);
+            if (n <= 1 || n >= job->skip) continue;
+#if HYDRA_BATCH_SIMD
+            // Exact 4/8/16 keep the register networks (no transposing)
+            if (n > 4 && n != 8 && n != 16 && n <= HYDRA_BATCH_MAX) {
+                unsigned c = hydra_log2((uint32_t)n - 1);     // Rows 2 << c
+                unsigned w = waiting[c]++;
+                pending[c][w] = arr;
+                pending_n[c][w] = n;
+                if (waiting[c] == HYDRA_BATCH_LANES) {
+                    hydra_batch_lanes(pending[c], pending_n[c], HYDRA_BATCH_LANES, 2u << c);
+                    waiting[c] = 0;
+                }
+                continue;
+            }
+#endif
+            hydra_batch_scalar(job, arr, n);
+        }
+    }
+    
+#if HYDRA_BATCH_SIMD
+    // Partial groups
+    for (unsigned c = 0; c < HYDRA_BATCH_CLASSES; c++) {
+        if (waiting[c]) hydra_batch_lanes(pending[c], pending_n[c], waiting[c], 2u << c);
+    }
+#endif
+}
+
+static void hydra_batch_run(HydraBatchJob* job, bool parallel) {
+    hydra_mutex_init(&job->lock);
+    job->next = 0;
+    if (!parallel) {
+        hydra_batch_worker(job, 0, 1);
+    } else {
+        bool transient = !hydra_workers_running;
+        if (transient) hydra_backend_start();
+        hydra_backend_run(hydra_batch_worker, job);
+        if (transient) hydra_backend_stop();
+    }
+    hydra_mutex_destroy(&job->lock);
+}
+
+/**
+ * Sort count independent arrays, items[i].arr of items[i].n elements
+ *
+ * Meant for many small arrays; any length works (past HYDRA_BATCH_MAX an
+ * array gets the single-core hydra_sort path, in place). Arrays must not
+ * overlap.
+ */
+void hydra_sort_batch(const HydraSlice* items, size_t count) {
+    HydraBatchJob job;
+    job.items = items;
+    job.offsets = NULL;
+    job.aux = NULL;
+    job.count = count;
+    job.skip = SIZE_MAX;
+    job.profile = HYDRA_PROFILE_BALANCED;
+    hydra_batch_run(&job, count >= HYDRA_BATCH_PARALLEL);
+}
+
+/**
+ * Sort count arrays of n elements each, array i at base + i * stride
+ * (stride >= n, in elements)
+ */
+void hydra_sort_batch_strided(int32_t* base, size_t n, size_t stride, size_t count) {
+    HydraBatchJob job;
+    job.items = NULL;
+    job.offsets = NULL;
+    job.base = base;
+    job.aux = NULL;
+    job.n = n;
+    job.stride = stride;
+    job.count = count;
+    job.skip = SIZE_MAX;
+    job.profile = HYDRA_PROFILE_BALANCED;
+    hydra_batch_run(&job, count >= HYDRA_BATCH_PARALLEL);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SEGMENTED SORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Sort every segment of a CSR layout on its own
+ *
+ * Segment i is values[offsets[i] .. offsets[i+1]) (offsets holds
+ * segments + 1 nondecreasing entries, e.g. the row pointers of a CSR
+ * adjacency matrix). aux, if not NULL, is scratch laid out like values
+ * (at least offsets[segments] elements).
+ *
+ * Segment sizes are usually very skewed, so they are split three ways:
+ * - a segment longer than one worker's share of all elements (and longer
+ *   than HYDRA_BLOCK_SIZE) gets every worker: hydra_sort, one at a time
+ * - the rest are claimed by the workers about HYDRA_SEGMENT_CHUNK elements
+ *   at a time, so a run of tiny rows is one claim, like one mid-sized row
+ * - within a claim, short segments are sorted as a batch (see
+ *   hydra_sort_batch: the vector networks on hosts), longer ones by
+ *   shell sort or the single-core selector
+ */
+void hydra_sort_segments(int32_t* values, const size_t* offsets, size_t segments,
+                         int32_t* aux, HydraProfile profile) {
+    if (segments == 0) return;
+    
+    size_t total = offsets[segments] - offsets[0];
+    bool parallel = total >= 2 * HYDRA_SEGMENT_CHUNK;
+    bool transient = parallel && !hydra_workers_running;
+    if (transient) hydra_init();
+    
+    HydraBatchJob job;
+    job.items = NULL;
+    job.offsets = offsets;
+    job.base = values;
+    job.aux = aux;
+    job.count = segments;
+    job.skip = SIZE_MAX;
+    job.profile = profile;
+    
+    unsigned workers = hydra_backend_workers();
+    if (parallel && workers > 1) {
+        size_t share = total / workers;
+        job.skip = (share > HYDRA_BLOCK_SIZE) ? share : HYDRA_BLOCK_SIZE;
+        for (size_t i = 0; i < segments; i++) {
+            size_t n = offsets[i + 1] - offsets[i];
+            if (n >= job.skip) {
+                hydra_sort(values + offsets[i], n, aux ? aux + offsets[i] : NULL, profile);
+            }
+        }
+    }
+    
+    hydra_batch_run(&job, parallel);
+    
+    if (transient) hydra_deinit();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// KEY-VALUE AND RECORD SORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * An int32 key drives the sort and a payload moves with it. All of these
+ * are stable: equal keys keep their input order.
+ *
+ * Keys in no particular order go to an LSD radix over the range-compressed
+ * key (the digits of hydra_radix_sort_i32), scattering each payload to the
+ * same slot as its key. Nearly sorted keys go to a bottom-up merge sort that
+ * skips merges whose runs are already in order, so sorted input costs one
+ * compare per block. Without aux the merges rotate in place instead:
+ * O(n log^2 n), and still stable.
+ */
+
+/**
+ * Stable insertion sort of keys, with values moved alongside
+ */
+HYDRA_RAMFUNC void hydra_kv_insertion(int32_t* keys, uint32_t* vals, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int32_t key = keys[i];
+        uint32_t val = vals[i];
+        size_t j = i;
+        while (j >= 1 && keys[j - 1] > key) {
+            keys[j] = keys[j - 1];
+            vals[j] = vals[j - 1];
+            j--;
+        }
+        keys[j] = key;
+        vals[j] = val;
+    }
+}
+
+/**
+ * Stable LSD radix sort of keys, with values moved alongside
+ *
+ * min_val and range_log2 come from hydra_analyze on keys; aux_keys and
+ * aux_vals must hold n each.
+ */
+HYDRA_RAMFUNC void hydra_radix_sort_kv(int32_t* keys, uint32_t* vals, size_t n,
+                                       int32_t* aux_keys, uint32_t* aux_vals,
+                                       int32_t min_val, uint8_t range_log2) {
+    HYDRA_RADIX_HIST_DECL(counts);
+    uint32_t base = (uint32_t)min_val;
+    int32_t* src_k = keys;
+    uint32_t* src_v = vals;
+    int32_t* dst_k = aux_keys;
+    uint32_t* dst_v = aux_vals;
+    
+    if (n <= 1) return;
+    
+    int shifts[HYDRA_RADIX_DIGITS];
+    uint32_t masks[HYDRA_RADIX_DIGITS];
+    int passes = hydra_radix_plan(range_log2, shifts, masks);
+    
+    // Fused count over the keys only: the values never affect a digit
+    memset(counts, 0, (size_t)passes * HYDRA_RADIX_BUCKETS * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = (uint32_t)keys[i] - base;
+        for (int pass = 0; pass < passes; pass++) {
+            counts[pass * HYDRA_RADIX_BUCKETS + ((key >> shifts[pass]) & masks[pass])]++;
+        }
+    }
+    
+    for (int pass = 0; pass < passes; pass++) {
+        uint32_t* c = counts + pass * HYDRA_RADIX_BUCKETS;
+        int shift = shifts[pass];
+        uint32_t mask = masks[pass];
+        
+        if (c[(((uint32_t)src_k[0] - base) >> shift) & mask] == n) continue;
+        
+        uint32_t sum = 0;
+        for (uint32_t d = 0; d <= mask; d++) {
+            uint32_t t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            int32_t x = src_k[i];
+            uint32_t slot = c[(((uint32_t)x - base) >> shift) & mask]++;
+            dst_k[slot] = x;
+            dst_v[slot] = src_v[i];
+        }
+        
+        int32_t* tk = src_k; src_k = dst_k; dst_k = tk;
+        uint32_t* tv = src_v; src_v = dst_v; dst_v = tv;
+    }
+    
+    if (src_k != keys) {
+        memcpy(keys, src_k, n * sizeof(int32_t));
+        memcpy(vals, src_v, n * sizeof(uint32_t));
+    }
+}
+
+/**
+ * Reverse keys[lo..hi) and vals[lo..hi)
+ */
+HYDRA_INLINE void hydra_kv_reverse(int32_t* keys, uint32_t* vals, size_t lo, size_t hi) {
+    for (; lo + 1 < hi; lo++, hi--) {
+        int32_t tk = keys[lo]; keys[lo] = keys[hi - 1]; keys[hi - 1] = tk;
+        uint32_t tv = vals[lo]; vals[lo] = vals[hi - 1]; vals[hi - 1] = tv;
+    }
+}
+
+/**
+ * Merge [0..mid) with [mid..n) stably, using aux if the left run fits,
+ * otherwise by rotation (as hydra_merge_runs)
+ */
+HYDRA_RAMFUNC void hydra_kv_merge(int32_t* keys, uint32_t* vals, size_t mid, size_t n,
+                                  int32_t* aux_keys, uint32_t* aux_vals, size_t aux_len) {
+    // Already in order (also ends the rotation recursion on empty runs)
+    if (mid == 0 || mid == n || keys[mid - 1] <= keys[mid]) return;
+    
+    if (mid <= aux_len) {
+        memcpy(aux_keys, keys, mid * sizeof(int32_t));
+        memcpy(aux_vals, vals, mid * sizeof(uint32_t));
+        size_t i = 0, j = mid, k = 0;
+        while (i < mid && j < n) {
+            // Left wins ties: stable
+            if (aux_keys[i] <= keys[j]) {
+                keys[k] = aux_keys[i];
+                vals[k++] = aux_vals[i++];
+            } else {
+                keys[k] = keys[j];
+                vals[k++] = vals[j++];
+            }
+        }
+        memcpy(keys + k, aux_keys + i, (mid - i) * sizeof(int32_t));
+        memcpy(vals + k, aux_vals + i, (mid - i) * sizeof(uint32_t));
+        return;
+    }
+    
+    // Split the longer run at its middle and the other at the matching key
+    size_t cut1, cut2;
+    if (mid >= n - mid) {
+        cut1 = mid / 2;
+        cut2 = mid + hydra_lower_bound(keys + mid, n - mid, keys[cut1]);
+    } else {
+        cut2 = mid + (n - mid) / 2;
+        cut1 = hydra_upper_bound(keys, mid, keys[cut2]);
+    }
+    
+    // Rotate [cut1..mid) past [mid..cut2)
+    hydra_kv_reverse(keys, vals, cut1, mid);
+    hydra_kv_reverse(keys, vals, mid, cut2);
+    hydra_kv_reverse(keys, vals, cut1, cut2);
+    size_t split = cut1 + (cut2 - mid);
+    
+    hydra_kv_merge(keys, vals, cut1, split, aux_keys, aux_vals, aux_len);
+    hydra_kv_merge(keys + split, vals + split, cut2 - split, n - split,
+                   aux_keys, aux_vals, aux_len);
+}
+
+/**
+ * Bottom-up stable merge sort: insertion-sorted blocks of
+ * HYDRA_SMALL_THRESHOLD, then doubling merges
+ */
+HYDRA_RAMFUNC void hydra_kv_merge_sort(int32_t* keys, uint32_t* vals, size_t n,
+                                       int32_t* aux_keys, uint32_t* aux_vals, size_t aux_len) {
+    for (size_t lo = 0; lo < n; lo += HYDRA_SMALL_THRESHOLD) {
+        size_t len = (n - lo < HYDRA_SMALL_THRESHOLD) ? n - lo : HYDRA_SMALL_THRESHOLD;
+        hydra_kv_insertion(keys + lo, vals + lo, len);
+    }
+    for (size_t width = HYDRA_SMALL_THRESHOLD; width < n; width *= 2) {
+        for (size_t lo = 0; lo + width < n; lo += 2 * width) {
+            size_t len = (n - lo < 2 * width) ? n - lo : 2 * width;
+            hydra_kv_merge(keys + lo, vals + lo, width, len, aux_keys, aux_vals, aux_len);
+        }
+    }
+}
+
+/**
+ * Sort keys, moving values[i] with keys[i]; stable
+ *
+ * @param keys      Keys to sort (in-place)
+ * @param values    Payloads (e.g. record indices), permuted with keys
+ * @param n         Number of pairs
+ * @param aux       Scratch of 2n words, or NULL for the in-place merge sort
+ *
+ * The engine comes from the HYDRA_PROFILE_STABLE selection: insertion for
+ * short or nearly sorted input, a merge sort for few runs, otherwise LSD
+ * radix with aux (split over the workers, values included, past
+ * HYDRA_PARALLEL_RADIX_THRESHOLD).
+ */
+void hydra_sort_kv(int32_t* keys, uint32_t* values, size_t n, uint32_t* aux) {
+    if (n <= 1) return;
+    if (n <= HYDRA_SMALL_THRESHOLD) {
+        hydra_kv_insertion(keys, values, n);
+        return;
+    }
+    
+    int32_t* aux_keys = (int32_t*)aux;
+    uint32_t* aux_vals = aux ? aux + n : NULL;
+    HydraFeatures f = hydra_analyze(keys, n);
+    HydraStrategy s = hydra_select_strategy_budget(&f, HYDRA_PROFILE_STABLE, hydra_counting_budget);
+    s = hydra_strategy_fit(s, &f, aux ? n : 0, HYDRA_PROFILE_STABLE);
+    // Counting sort runs below in the radix, which needs the pair buffer
+    if (!aux && s.algorithm == ALG_COUNTING_I32) s.algorithm = ALG_POWERSORT;
+
+    switch (s.algorithm) {
+        case ALG_RADIX_256:
+        case ALG_COUNTING_I32:
+            // Counts alone cannot carry payloads: a small range is a radix
+            // with few passes
+            if (s.use_parallel) {
+                // Every pass split over the workers, payload and all
+                bool transient = !hydra_workers_running;
+                if (transient) hydra_backend_start();
+                hydra_parallel_radix_kv_on(&hydra_default_workers, &hydra_radix_job, keys, values,
+                                           aux_keys, aux_vals, n, f.min_val, f.range_log2);
+                if (transient) hydra_backend_stop();
+            } else {
+                hydra_radix_sort_kv(keys, values, n, aux_keys, aux_vals, f.min_val, f.range_log2);
+            }
+            break;
+        case ALG_INSERTION:
+            hydra_kv_insertion(keys, values, n);
+            break;
+        default:
+            hydra_kv_merge_sort(keys, values, n, aux_keys, aux_vals, aux ? n : 0);
+            break;
+    }
+}
+
+/**
+ * Copy one record; the common sizes are a fixed-size memcpy (two loads)
+ */
+HYDRA_INLINE void hydra_record_copy(uint8_t* dst, const uint8_t* src, size_t size) {
+    switch (size) {
+        case 4:  memcpy(dst, src, 4);  break;
+        case 8:  memcpy(dst, src, 8);  break;
+        case 12: memcpy(dst, src, 12); break;
+        case 16: memcpy(dst, src, 16); break;
+        default: memcpy(dst, src, size); break;
+    }
+}
+
+HYDRA_INLINE int32_t hydra_record_key(const uint8_t* record, size_t key_offset) {
+    int32_t key;
+    memcpy(&key, record + key_offset, sizeof(key));
+    return key;
+}
+
+/**
+ * Workspace hydra_sort_records needs, in bytes
+ */
+size_t hydra_records_workspace(size_t n, size_t record_size) {
+    if (record_size <= HYDRA_RECORD_TAG_BYTES) return n * record_size;
+    return 4 * n * sizeof(uint32_t) + record_size;
+}
+
+/**
+ * Stable LSD radix moving whole records (HYDRA_RECORD_TAG_BYTES or less)
+ */
+HYDRA_RAMFUNC void hydra_radix_sort_records(uint8_t* records, size_t n, size_t size,
+                                            size_t key_offset, uint8_t* aux) {
+    HYDRA_RADIX_HIST_DECL(counts);
+    uint8_t* src = records;
+    uint8_t* dst = aux;
+    
+    int32_t min_val = hydra_record_key(records, key_offset);
+    int32_t max_val = min_val;
+    for (size_t i = 1; i < n; i++) {
+        int32_t key = hydra_record_key(records + i * size, key_offset);
+        if (key < min_val) min_val = key;
+        if (key > max_val) max_val = key;
+    }
+    uint32_t base = (uint32_t)min_val;
+    uint32_t range = (uint32_t)max_val - base;
+    if (range == 0) return;
+    
+    int shifts[HYDRA_RADIX_DIGITS];
+    uint32_t masks[HYDRA_RADIX_DIGITS];
+    int passes = hydra_radix_plan((uint8_t)hydra_log2(range), shifts, masks);
+    
+    memset(counts, 0, (size_t)passes * HYDRA_RADIX_BUCKETS * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = (uint32_t)hydra_record_key(records + i * size, key_offset) - base;
+        for (int pass = 0; pass < passes; pass++) {
+            counts[pass * HYDRA_RADIX_BUCKETS + ((key >> shifts[pass]) & masks[pass])]++;
+        }
+    }
+    
+    for (int pass = 0; pass < passes; pass++) {
+        uint32_t* c = counts + pass * HYDRA_RADIX_BUCKETS;
+        int shift = shifts[pass];
+        uint32_t mask = masks[pass];
+        
+        uint32_t first = (uint32_t)hydra_record_key(src, key_offset) - base;
+        if (c[(first >> shift) & mask] == n) continue;
+        
+        uint32_t sum = 0;
+        for (uint32_t d = 0; d <= mask; d++) {
+            uint32_t t = c[d];
+            c[d] = sum;
+            sum += t;
+        }
+        
+        for (size_t i = 0; i < n; i++) {
+            const uint8_t* rec = src + i * size;
+            uint32_t key = (uint32_t)hydra_record_key(rec, key_offset) - base;
+            hydra_record_copy(dst + (size_t)c[(key >> shift) & mask]++ * size, rec, size);
+        }
+        
+        uint8_t* t = src; src = dst; dst = t;
+    }
+    
+    if (src != records) memcpy(records, src, n * size);
+}
+
+/**
+ * Sort fixed-size records by the int32 at key_offset in each; stable
+ *
+ * Records of HYDRA_RECORD_TAG_BYTES or less are moved by a radix sort
+ * directly. Larger ones are tag sorted: (key, index) pairs go through
+ * hydra_sort_kv, then the records are permuted in place along the cycles
+ * of the result, so each record moves once (plus once per cycle).
+ * workspace must hold hydra_records_workspace(n, record_size) bytes and be
+ * int32-aligned; keys may be unaligned.
+ */
+void hydra_sort_records(void* records, size_t n, size_t record_size, size_t key_offset,
+                        void* workspace) {
+    uint8_t* recs = (uint8_t*)records;
+    if (n <= 1) return;
+    
+    if (record_size <= HYDRA_RECORD_TAG_BYTES) {
+        hydra_radix_sort_records(recs, n, record_size, key_offset, (uint8_t*)workspace);
+        return;
+    }
+    
+    int32_t* tags = (int32_t*)workspace;
+    uint32_t* perm = (uint32_t*)workspace + n;
+    uint8_t* temp = (uint8_t*)((uint32_t*)workspace + 4 * n);
+    for (size_t i = 0; i < n; i++) {
+        tags[i] = hydra_record_key(recs + i * record_size, key_offset);
+        perm[i] = (uint32_t)i;
+    }
+    hydra_sort_kv(tags, perm, n, perm + n);
+    
+    // Gather in place: slot i takes record perm[i]; a placed slot has perm[i] == i
+    for (size_t i = 0; i < n; i++) {
+        if (perm[i] == i) continue;
+        memcpy(temp, recs + i * record_size, record_size);
+        size_t j = i;
+        while (perm[j] != i) {
+            size_t from = perm[j];
+            memcpy(recs + j * record_size, recs + from * record_size, record_size);
+            perm[j] = (uint32_t)j;
+            j = from;
+        }
+        memcpy(recs + j * record_size, temp, record_size);
+        perm[j] = (uint32_t)j;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ARGSORT AND PERMUTATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Indirect order: by key, then by index, so the result is the stable order
+ * even from an unstable sort
  */
-void hydra_sort(int32_t* arr, size_t n, int32_t* aux, HydraProfile profile) {
+HYDRA_INLINE bool hydra_arg_less(const int32_t* keys, uint32_t a, uint32_t b) {
+    return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+}
+
+HYDRA_RAMFUNC void hydra_arg_heapsort(const int32_t* keys, uint32_t* idx, size_t n) {
+    for (size_t start = n / 2; start-- > 0;) {
+        for (size_t i = start;;) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && hydra_arg_less(keys, idx[child], idx[child + 1])) child++;
+            if (!hydra_arg_less(keys, idx[i], idx[child])) break;
+            uint32_t t = idx[i]; idx[i] = idx[child]; idx[child] = t;
+            i = child;
+        }
+    }
+    for (size_t end = n - 1; end > 0; end--) {
+        uint32_t t = idx[0]; idx[0] = idx[end]; idx[end] = t;
+        for (size_t i = 0;;) {
+            size_t child = 2 * i + 1;
+            if (child >= end) break;
+            if (child + 1 < end && hydra_arg_less(keys, idx[child], idx[child + 1])) child++;
+            if (!hydra_arg_less(keys, idx[i], idx[child])) break;
+            t = idx[i]; idx[i] = idx[child]; idx[child] = t;
+            i = child;
+        }
+    }
+}
+
+/**
+ * Introsort of indices by keys[index]: median-of-three Hoare partition,
+ * heapsort past the depth limit, insertion sort at 16 and below.
+ * Recurses into the smaller side only.
+ */
+HYDRA_RAMFUNC void hydra_arg_introsort(const int32_t* keys, uint32_t* idx, size_t n, int depth) {
+    while (n > HYDRA_SMALL_THRESHOLD) {
+        if (depth-- == 0) {
+            hydra_arg_heapsort(keys, idx, n);
+            return;
+        }
+        
+        // Median of three into idx[0], the largest of the three at idx[n-1]
+        size_t mid = n / 2;
+        uint32_t t;
+        if (hydra_arg_less(keys, idx[n - 1], idx[mid])) { t = idx[mid]; idx[mid] = idx[n - 1]; idx[n - 1] = t; }
+        if (hydra_arg_less(keys, idx[n - 1], idx[0]))   { t = idx[0]; idx[0] = idx[n - 1]; idx[n - 1] = t; }
+        if (hydra_arg_less(keys, idx[0], idx[mid]))     { t = idx[0]; idx[0] = idx[mid]; idx[mid] = t; }
+        uint32_t pivot = idx[0];
+        
+        // Keys are distinct under hydra_arg_less, so the scans stop at
+        // idx[n-1] (> pivot) and idx[0] (the pivot) at the latest
+        size_t i = 0, j = n;
+        for (;;) {
+            do i++; while (hydra_arg_less(keys, idx[i], pivot));
+            do j--; while (hydra_arg_less(keys, pivot, idx[j]));
+            if (i >= j) break;
+            t = idx[i]; idx[i] = idx[j]; idx[j] = t;
+        }
+        idx[0] = idx[j];
+        idx[j] = pivot;
+        
+        if (j < n - j - 1) {
+            hydra_arg_introsort(keys, idx, j, depth);
+            idx += j + 1;
+            n -= j + 1;
+        } else {
+            hydra_arg_introsort(keys, idx + j + 1, n - j - 1, depth);
+            n = j;
+        }
+    }
+    
+    for (size_t i = 1; i < n; i++) {
+        uint32_t x = idx[i];
+        size_t j = i;
+        while (j >= 1 && hydra_arg_less(keys, x, idx[j - 1])) {
+            idx[j] = idx[j - 1];
+            j--;
+        }
+        idx[j] = x;
+    }
+}
+
+/**
+ * Write the permutation that sorts keys into idx; keys are not modified
+ *
+ * idx[i] is the index of the i-th smallest key, equal keys in index order
+ * (stable). With aux (3n words) this is hydra_sort_kv on a copy of the
+ * keys carrying indices: radix, split over the workers for large n, or
+ * the merge sort for nearly sorted keys. Without aux the indices are
+ * introsorted by key, ties broken by index. n must be below 2^32.
+ */
+void hydra_argsort(const int32_t* keys, uint32_t* idx, size_t n, uint32_t* aux) {
+    for (size_t i = 0; i < n; i++) idx[i] = (uint32_t)i;
     if (n <= 1) return;
     
-    // Tiny arrays: direct register sort
-    if (n <= 4) { hydra_sort4(arr); return; }
-    if (n <= 8) { hydra_sort8(arr); return; }
-    if (n <= 16) { hydra_sort16(arr); return; }
+    if (aux) {
+        memcpy(aux, keys, n * sizeof(int32_t));
+        hydra_sort_kv((int32_t*)aux, idx, n, aux + n);
+    } else {
+        hydra_arg_introsort(keys, idx, n, 2 * (int)hydra_log2((uint32_t)n));
+    }
+}
+
+/**
+ * Swap element a with element b of size bytes
+ */
+HYDRA_INLINE void hydra_swap_elements(uint8_t* a, uint8_t* b, size_t size) {
+    switch (size) {
+        case 1: { uint8_t t = *a; *a = *b; *b = t; break; }
+        case 2: { uint16_t x, y; memcpy(&x, a, 2); memcpy(&y, b, 2); memcpy(a, &y, 2); memcpy(b, &x, 2); break; }
+        case 4: { uint32_t x, y; memcpy(&x, a, 4); memcpy(&y, b, 4); memcpy(a, &y, 4); memcpy(b, &x, 4); break; }
+        case 8: { uint64_t x, y; memcpy(&x, a, 8); memcpy(&y, b, 8); memcpy(a, &y, 8); memcpy(b, &x, 8); break; }
+        default:
+            for (size_t i = 0; i < size; i++) { uint8_t t = a[i]; a[i] = b[i]; b[i] = t; }
+            break;
+    }
+}
+
+#define HYDRA_PERM_VISITED 0x80000000u
+
+/**
+ * Apply perm to several arrays in place: afterwards columns[c][i] holds
+ * what was columns[c][perm[i]] (the gather that hydra_argsort's output
+ * describes)
+ *
+ * Without scratch every cycle of perm is walked once, swapping along it in
+ * all columns at the same step, so no column needs an n-sized temporary.
+ * Visited slots are marked in the top bit of perm, which is cleared again
+ * before return (perm comes back unchanged; n must be below 2^31). The
+ * walk is a chain of dependent loads: on a cached host a random
+ * permutation costs several times a plain gather. With scratch (n elements
+ * of the widest column) each column is gathered through it and copied
+ * back instead, one column at a time.
+ *
+ * @param perm      Permutation of 0..n-1
+ * @param n         Elements per column
+ * @param columns   count column base pointers
+ * @param sizes     Element size in bytes of each column
+ * @param count     Number of columns
+ * @param scratch   n * max(sizes) bytes, or NULL to follow cycles in place
+ */
+void hydra_apply_permutation(uint32_t* perm, size_t n, void* const* columns,
+                             const size_t* sizes, size_t count, void* scratch) {
+    if (scratch) {
+        uint8_t* out = (uint8_t*)scratch;
+        for (size_t c = 0; c < count; c++) {
+            const uint8_t* col = (const uint8_t*)columns[c];
+            size_t size = sizes[c];
+            switch (size) {
+                case 4:
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * 4, col + (size_t)perm[i] * 4, 4);
+                    break;
+                case 8:
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * 8, col + (size_t)perm[i] * 8, 8);
+                    break;
+                default:
+                    for (size_t i = 0; i < n; i++) memcpy(out + i * size, col + (size_t)perm[i] * size, size);
+                    break;
+            }
+            memcpy(columns[c], out, n * size);
+        }
+        return;
+    }
     
-    // Analyze input
-    HydraFeatures features = hydra_analyze(arr, n);
+    for (size_t i = 0; i < n; i++) {
+        if (perm[i] & HYDRA_PERM_VISITED) continue;
+        
+        // Slot j takes slot k's element: swap, then the old j element
+        // travels on to k until the cycle closes at i
+        size_t j = i;
+        size_t k = perm[i];
+        perm[i] |= HYDRA_PERM_VISITED;
+        while (k != i) {
+            for (size_t c = 0; c < count; c++) {
+                uint8_t* col = (uint8_t*)columns[c];
+                hydra_swap_elements(col + j * sizes[c], col + k * sizes[c], sizes[c]);
+            }
+            j = k;
+            k = perm[k];
+            perm[j] |= HYDRA_PERM_VISITED;
+        }
+    }
+    for (size_t i = 0; i < n; i++) perm[i] &= ~HYDRA_PERM_VISITED;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SELECTION (NTH ELEMENT, TOP-K, MULTI-RANK)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * Selection leaves arr partitioned around rank k: arr[k] holds the value a
+ * full sort would put there, nothing before it is larger and nothing after
+ * it is smaller. Only the side holding k is ever partitioned again.
+ *
+ * On a single core that is introselect on the pdqsort partitions, which
+ * beats narrowing by radix digit there: the digit split moves elements
+ * with a branch apiece, the block partition does not.
+ *
+ * With aux and more than one worker, ranges from
+ * HYDRA_PARALLEL_RADIX_THRESHOLD are narrowed by radix digit first. Each
+ * level is one parallel radix pass: the workers count the top digit of
+ * their slices, which gives the bucket of k outright, scatter into aux by
+ * digit and copy back. Only k's bucket goes on to the next digit, and
+ * random keys leave n / 2048 after the first level.
+ *
+ * Introselect uses the same step as pdqsort for runs of keys equal to the
+ * previous pivot. After log2(n) bad splits (the kept side above 7/8 of
+ * the range), every pivot is a median of medians of five, which bounds
+ * the rest to O(n).
+ */
+
+HYDRA_RAMFUNC void hydra_introselect(int32_t* arr, size_t lo, size_t hi, size_t k,
+                                     int bad_allowed, bool leftmost);
+
+/**
+ * Median of the medians of five to arr[lo] (at least 3/10 of the range is
+ * on either side of it)
+ */
+HYDRA_RAMFUNC void hydra_mom_pivot(int32_t* arr, size_t lo, size_t hi, bool leftmost) {
+    size_t groups = (hi - lo + 1) / 5;
     
-    // Select strategy
-    HydraStrategy strategy = hydra_select_strategy(&features, profile);
+    // Group g's median goes to arr[lo + g], inside a group already done
+    for (size_t g = 0; g < groups; g++) {
+        int32_t* group = arr + lo + 5 * g;
+        hydra_insertion_small(group, 5);
+        hydra_swap_ptr(arr + lo + g, group + 2);
+    }
+    size_t mid = lo + groups / 2;
+    hydra_introselect(arr, lo, lo + groups - 1, mid, 0, leftmost);
+    hydra_swap_ptr(arr + lo, arr + mid);
+}
+
+/**
+ * Select rank k within arr[lo..hi]; bad_allowed of 0 takes a median of
+ * medians for every pivot. Unless leftmost, arr[lo - 1] must not be
+ * larger than anything in the range.
+ */
+HYDRA_RAMFUNC void hydra_introselect(int32_t* arr, size_t lo, size_t hi, size_t k,
+                                     int bad_allowed, bool leftmost) {
+    while (hi - lo + 1 >= HYDRA_PDQ_INSERTION) {
+        size_t n = hi - lo + 1;
+        
+        // Pivot to arr[lo], as pdqsort, or the median of medians
+        if (bad_allowed > 0) {
+            int32_t* b = arr + lo;
+            int32_t* e = arr + hi;
+            size_t half = n / 2;
+            if (n > HYDRA_PDQ_NINTHER) {
+                hydra_sort3_ptr(b, b + half, e);
+                hydra_sort3_ptr(b + 1, b + half - 1, e - 1);
+                hydra_sort3_ptr(b + 2, b + half + 1, e - 2);
+                hydra_sort3_ptr(b + half - 1, b + half, b + half + 1);
+                hydra_swap_ptr(b, b + half);
+            } else {
+                hydra_sort3_ptr(b + half, b, e);
+            }
+        } else {
+            hydra_mom_pivot(arr, lo, hi, leftmost);
+        }
+        
+        // Pivot equals the previous pivot: drop every key equal to it
+        if (!leftmost && !(arr[lo - 1] < arr[lo])) {
+            size_t equal_end = hydra_partition_left(arr, lo, hi);
+            if (k <= equal_end) return;
+            lo = equal_end + 1;
+            continue;
+        }
+        
+        bool already_partitioned;
+        size_t pivot = (hydra_partition_scheme == HYDRA_PARTITION_BLOCK)
+            ? hydra_partition_right_block(arr, lo, hi, &already_partitioned)
+            : hydra_partition_right(arr, lo, hi, &already_partitioned);
+        if (k == pivot) return;
+        
+        size_t kept = (k < pivot) ? pivot - lo : hi - pivot;
+        if (bad_allowed > 0 && kept > n - n / 8) bad_allowed--;
+        if (k < pivot) {
+            hi = pivot - 1;
+        } else {
+            lo = pivot + 1;
+            leftmost = false;
+        }
+    }
+    hydra_insertion_small(arr + lo, hi - lo + 1);
+}
+
+/**
+ * Copy the job's dst slice back over src, split over the workers
+ */
+static void hydra_select_copy_worker(void* arg, unsigned worker, unsigned workers) {
+    HydraRadixJob* job = (HydraRadixJob*)arg;
+    size_t lo = job->n * worker / workers;
+    size_t hi = job->n * (worker + 1) / workers;
+    memcpy((int32_t*)job->src + lo, job->dst + lo, (hi - lo) * sizeof(int32_t));
+}
+
+/**
+ * Parallel radix levels over arr[*lo..*hi), through aux, until k's bucket
+ * is below HYDRA_PARALLEL_RADIX_THRESHOLD; narrows [*lo, *hi) to it.
+ * Returns false if the bucket left holds a single key (k is in place).
+ */
+static bool hydra_select_narrow(HydraWorkers* w, HydraRadixJob* job, int32_t* arr,
+                                size_t* lo, size_t* hi, size_t k, int32_t* aux) {
+    // Keys biased to unsigned order; a top digit all keys share costs only
+    // its (parallel) count
+    int top = 32;
+    while (top > 0 && *hi - *lo >= HYDRA_PARALLEL_RADIX_THRESHOLD) {
+        int width = top < HYDRA_RADIX_DIGIT_BITS ? top : HYDRA_RADIX_DIGIT_BITS;
+        size_t n = *hi - *lo;
+        top -= width;
+        
+        job->src = arr + *lo;
+        job->dst = aux + *lo;
+        job->src16 = NULL;
+        job->dst16 = NULL;
+        job->src_vals = NULL;
+        job->dst_vals = NULL;
+        job->n = n;
+        job->base = (uint32_t)INT32_MIN;
+        job->shift = top;
+        job->mask = (1u << width) - 1;
+        if (!hydra_radix_parallel_pass(w, job)) continue;
+        
+        // The last worker's offsets end up at each bucket's end
+        const uint32_t* ends = job->offsets[hydra_workers_count(w) - 1];
+        uint32_t d = 0;
+        while (ends[d] <= k - *lo) d++;
+        size_t start = d ? ends[d - 1] : 0;
+        size_t end = ends[d];
+        hydra_workers_run(w, hydra_select_copy_worker, job);
+        
+        *hi = *lo + end;
+        *lo += start;
+    }
+    return top > 0;
+}
+
+/**
+ * Select rank k within arr[lo..hi); arr[lo - 1], if lo > 0, must not be
+ * larger than anything in the range. w (running, with aux) narrows large
+ * ranges across the workers first.
+ */
+static void hydra_select_range(int32_t* arr, size_t lo, size_t hi, size_t k,
+                               int32_t* aux, HydraWorkers* w) {
+    if (w && hi - lo >= HYDRA_PARALLEL_RADIX_THRESHOLD &&
+        !hydra_select_narrow(w, &hydra_radix_job, arr, &lo, &hi, k, aux)) {
+        return;
+    }
+    if (hi - lo > 1) {
+        hydra_introselect(arr, lo, hi - 1, k, (int)hydra_log2((uint32_t)(hi - lo)), lo == 0);
+    }
+}
+
+/**
+ * Partition arr around rank k (0-based): afterwards arr[k] is the k-th
+ * smallest, arr[0..k) <= arr[k] <= arr(k..n)
+ *
+ * @param aux   n elements, or NULL. With aux, inputs past
+ *              HYDRA_PARALLEL_RADIX_THRESHOLD narrow across the workers.
+ */
+void hydra_nth_element(int32_t* arr, size_t n, size_t k, int32_t* aux) {
+    if (k >= n || n <= 1) return;
     
-    // Execute
-    if (strategy.use_partitioning && strategy.use_parallel) {
-        // Large array: parallel block sort + merge
-        hydra_parallel_sort(arr, n, strategy.block_size);
+    bool parallel = aux && n >= HYDRA_PARALLEL_RADIX_THRESHOLD;
+    bool transient = parallel && !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    parallel = parallel && hydra_backend_workers() > 1;
+    hydra_select_range(arr, 0, n, k, aux, parallel ? &hydra_default_workers : NULL);
+    if (transient) hydra_backend_stop();
+}
+
+/**
+ * Select every rank in ks (ascending, each below n); afterwards arr[ks[i]]
+ * holds its sorted value and arr is partitioned around each of them
+ *
+ * The middle rank is selected first, and the ranks on either side only
+ * look at their own side of it: O(n log count).
+ */
+static void hydra_nth_elements_impl(int32_t* arr, size_t lo, size_t hi, const size_t* ks,
+                                    size_t count, int32_t* aux, HydraWorkers* w) {
+    while (count > 0) {
+        size_t mid = count / 2;
+        size_t k = ks[mid];
+        hydra_select_range(arr, lo, hi, k, aux, w);
         
-        // Merge sorted blocks (TODO: implement cascade merge)
-        // For now, fall through to final pass
+        hydra_nth_elements_impl(arr, lo, k, ks, mid, aux, w);
         
-    } else {
-        // Single algorithm execution
-        switch (strategy.algorithm) {
-            case ALG_NETWORK_4:
-                hydra_sort4(arr);
-                break;
-            case ALG_NETWORK_8:
-                hydra_sort8(arr);
-                break;
-            case ALG_NETWORK_16:
-                hydra_sort16(arr);
-                break;
-            case ALG_INSERTION_SENTINEL:
-                hydra_insertion_sentinel(arr, n);
-                break;
-            case ALG_SHELL_CIURA:
-                hydra_shell_sort(arr, n);
-                break;
-            case ALG_RADIX_256:
-                hydra_radix_sort_256((uint32_t*)arr, (uint32_t*)aux, n);
-                break;
-            case ALG_INTROSORT:
-            default:
-                hydra_introsort(arr, n);
-                break;
+        // Ranks repeated or right after k are already in place
+        size_t next = mid + 1;
+        while (next < count && ks[next] == k) next++;
+        lo = k + 1;
+        ks += next;
+        count -= next;
+    }
+}
+
+void hydra_nth_elements(int32_t* arr, size_t n, const size_t* ks, size_t count, int32_t* aux) {
+    if (n <= 1 || count == 0) return;
+    
+    bool parallel = aux && n >= HYDRA_PARALLEL_RADIX_THRESHOLD;
+    bool transient = parallel && !hydra_workers_running;
+    if (transient) hydra_backend_start();
+    parallel = parallel && hydra_backend_workers() > 1;
+    hydra_nth_elements_impl(arr, 0, n, ks, count, aux, parallel ? &hydra_default_workers : NULL);
+    if (transient) hydra_backend_stop();
+}
+
+/**
+ * Smallest k of arr into arr[0..k), sorted; the rest is left in any order
+ *
+ * Small k keeps a max-heap of the k smallest so far in arr[0..k) and
+ * makes one pass over the rest, which mostly costs one compare against
+ * the root. Larger k, or input that keeps replacing the root, selects
+ * rank k - 1 and sorts what is left of it.
+ *
+ * @param aux   n elements, or NULL (as hydra_nth_element and hydra_sort)
+ */
+void hydra_partial_sort(int32_t* arr, size_t n, size_t k, int32_t* aux) {
+    if (k > n) k = n;
+    if (k <= 1) {
+        if (k == 1 && n > 1) {
+            size_t m = 0;
+            for (size_t i = 1; i < n; i++) if (arr[i] < arr[m]) m = i;
+            hydra_swap_ptr(arr, arr + m);
+        }
+        return;
+    }
+    
+    if (k <= n / HYDRA_TOPK_HEAP_DIV) {
+        // Random input replaces the root about k ln(n / k) times; falling
+        // input would replace it every time, so past n / 16 select instead
+        size_t budget = n / 16;
+        size_t i = k;
+        for (size_t j = k / 2; j > 0; j--) hydra_heapify(arr, k, j - 1);
+        for (; i < n; i++) {
+            if (arr[i] < arr[0]) {
+                hydra_swap_ptr(arr, arr + i);
+                hydra_heapify(arr, k, 0);
+                if (--budget == 0) break;
+            }
+        }
+        if (i >= n) {
+            for (size_t j = k - 1; j > 0; j--) {
+                hydra_swap_ptr(arr, arr + j);
+                hydra_heapify(arr, j, 0);
+            }
+            return;
+        }
+    }
+    
+    hydra_nth_element(arr, n, k - 1, aux);
+    hydra_sort(arr, k - 1, aux, HYDRA_PROFILE_BALANCED);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUANTILES (READ-ONLY)
+// ═══════════════════════════════════════════════════════════════════════════
+
+/*
+ * Exact order statistics from digit histograms, without moving or writing
+ * the input. Keys are taken in unsigned order (int32 with the sign bit
+ * flipped) and resolved from the top digit down.
+ *
+ * A min/max sweep comes first: all keys share the bits above the highest
+ * bit in which the extremes differ, so the first counting pass takes the
+ * HYDRA_RADIX_DIGIT_BITS just below it, whatever their alignment. Fixed
+ * digits would waste that pass on bits the data never varies in, and a
+ * digit that stays constant turns its counter into a store-to-load chain.
+ *
+ * Later passes look only at the keys in a rank's bucket. A bucket that
+ * fits the histogram memory is copied there and selected directly;
+ * otherwise its next digit is counted. Random keys and latency-like data
+ * need the sweep and two passes, and the passes serve up to
+ * HYDRA_QUANTILE_RANKS ranks at once. Inputs that fit the table whole are
+ * simply copied there. Memory is the radix histogram table: no aux,
+ * nothing that grows with n.
+ */
+
+typedef struct {
+    uint32_t prefix;            // Key bits decided so far
+    uint32_t high;              // Mask of those bits
+    int top;                    // Undecided low bits
+    size_t rank;                // Rank among the keys matching prefix
+    size_t size;                // Keys matching prefix
+    int group;                  // Group in the current pass, or -1
+} HydraQuantileTarget;
+
+typedef struct {
+    uint32_t prefix;
+    uint32_t high;
+    int shift;                  // Digit counted, when mask != 0
+    uint32_t mask;
+    uint32_t* table;            // Its counts, or the matching keys (mask == 0)
+    size_t len;
+} HydraQuantileGroup;
+
+HYDRA_INLINE uint32_t hydra_quantile_key(const int32_t* src32, const uint16_t* src16, size_t i) {
+    return src32 ? (uint32_t)src32[i] ^ 0x80000000u : src16[i];
+}
+
+// The scans below are inlined with one source NULL so each gets its own loop
+
+HYDRA_INLINE void hydra_quantile_range(const int32_t* src32, const uint16_t* src16, size_t n,
+                                       uint32_t* lo, uint32_t* hi) {
+    uint32_t min = UINT32_MAX, max = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = hydra_quantile_key(src32, src16, i);
+        min = key < min ? key : min;
+        max = key > max ? key : max;
+    }
+    *lo = min;
+    *hi = max;
+}
+
+HYDRA_INLINE void hydra_quantile_count(const int32_t* src32, const uint16_t* src16, size_t n,
+                                       int shift, uint32_t mask, uint32_t* table) {
+    for (size_t i = 0; i < n; i++) {
+        table[(hydra_quantile_key(src32, src16, i) >> shift) & mask]++;
+    }
+}
+
+// Every group fixes the digit at shift, so a lookup there rejects most
+// keys and names the group of the rest (0xFF: several share the digit).
+// Group fields are copied to locals the table stores cannot alias.
+HYDRA_INLINE void hydra_quantile_scan(const int32_t* src32, const uint16_t* src16, size_t n,
+                                      HydraQuantileGroup* groups, int ngroups, int shift) {
+    uint32_t prefix[HYDRA_QUANTILE_RANKS], high[HYDRA_QUANTILE_RANKS], mask[HYDRA_QUANTILE_RANKS];
+    int digit[HYDRA_QUANTILE_RANKS];
+    uint32_t* table[HYDRA_QUANTILE_RANKS];
+    size_t len[HYDRA_QUANTILE_RANKS];
+    uint8_t route[HYDRA_RADIX_BUCKETS] = {0};
+    for (int g = 0; g < ngroups; g++) {
+        prefix[g] = groups[g].prefix;
+        high[g] = groups[g].high;
+        mask[g] = groups[g].mask;
+        digit[g] = groups[g].shift;
+        table[g] = groups[g].table;
+        len[g] = 0;
+        uint8_t* r = &route[(prefix[g] >> shift) & (HYDRA_RADIX_BUCKETS - 1)];
+        *r = *r ? 0xFF : (uint8_t)(g + 1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = hydra_quantile_key(src32, src16, i);
+        int r = route[(key >> shift) & (HYDRA_RADIX_BUCKETS - 1)];
+        if (!r) continue;
+        if (r != 0xFF) {
+            int g = r - 1;
+            if ((key & high[g]) != prefix[g]) continue;
+            if (mask[g]) table[g][(key >> digit[g]) & mask[g]]++;
+            else table[g][len[g]++] = key ^ 0x80000000u;
+            continue;
+        }
+        for (int g = 0; g < ngroups; g++) {
+            if ((key & high[g]) != prefix[g]) continue;
+            if (mask[g]) table[g][(key >> digit[g]) & mask[g]]++;
+            else table[g][len[g]++] = key ^ 0x80000000u;
+        }
+    }
+    for (int g = 0; g < ngroups; g++) groups[g].len = len[g];
+}
+
+// Same, when every group has decided just the first digit: the digit alone
+// names the group, so counts go to its table (or to trash, indexed like a
+// group's so no counter turns hot) without a branch; only copies test
+HYDRA_INLINE void hydra_quantile_scan_first(const int32_t* src32, const uint16_t* src16, size_t n,
+                                            HydraQuantileGroup* groups, int ngroups, int shift,
+                                            uint32_t* table, uint32_t* trash) {
+    uint16_t offset[HYDRA_RADIX_BUCKETS];
+    uint8_t copy[HYDRA_RADIX_BUCKETS] = {0};
+    uint32_t* dest[HYDRA_QUANTILE_RANKS];
+    size_t len[HYDRA_QUANTILE_RANKS];
+    int digit = 0;
+    uint32_t mask = 0;
+    for (uint32_t d = 0; d < HYDRA_RADIX_BUCKETS; d++) offset[d] = (uint16_t)(trash - table);
+    for (int g = 0; g < ngroups; g++) {
+        uint32_t d = (groups[g].prefix >> shift) & (HYDRA_RADIX_BUCKETS - 1);
+        dest[g] = groups[g].table;
+        len[g] = 0;
+        if (groups[g].mask) {
+            offset[d] = (uint16_t)(groups[g].table - table);
+            digit = groups[g].shift;
+            mask = groups[g].mask;
+        } else {
+            copy[d] = (uint8_t)(g + 1);
         }
     }
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = hydra_quantile_key(src32, src16, i);
+        uint32_t d = (key >> shift) & (HYDRA_RADIX_BUCKETS - 1);
+        if (mask) table[offset[d] + ((key >> digit) & mask)]++;
+        int c = copy[d];
+        if (c) dest[c - 1][len[c - 1]++] = key ^ 0x80000000u;
+    }
+    for (int g = 0; g < ngroups; g++) groups[g].len = len[g];
 }
 
 /**
- * Specialized version for uint8_t (NUCLEAR OPTION)
- * Up to 30x+ faster than comparison sorts
+ * Keys at up to HYDRA_QUANTILE_RANKS ranks of src32 or src16
  */
-void hydra_sort_u8(uint8_t* arr, size_t n) {
-    hydra_counting_sort_u8(arr, n);
+static void hydra_quantile_keys(const int32_t* src32, const uint16_t* src16, size_t n,
+                                const size_t* ranks, size_t count, uint32_t* keys) {
+    HYDRA_RADIX_HIST_DECL(table);
+    HydraQuantileTarget targets[HYDRA_QUANTILE_RANKS];
+    HydraQuantileGroup groups[HYDRA_QUANTILE_RANKS];
+    const int digit_bits = HYDRA_RADIX_DIGIT_BITS;
+    
+    // Small inputs fit the table whole
+    if (n <= HYDRA_RADIX_HIST_WORDS) {
+        int32_t* copy = (int32_t*)table;
+        for (size_t i = 0; i < n; i++) copy[i] = (int32_t)(hydra_quantile_key(src32, src16, i) ^ 0x80000000u);
+        for (size_t r = 0; r < count; r++) {
+            hydra_introselect(copy, 0, n - 1, ranks[r], (int)hydra_log2((uint32_t)n), true);
+            keys[r] = (uint32_t)copy[ranks[r]] ^ 0x80000000u;
+        }
+        return;
+    }
+    
+    uint32_t lo, hi;
+    if (src32) hydra_quantile_range(src32, NULL, n, &lo, &hi);
+    else hydra_quantile_range(NULL, src16, n, &lo, &hi);
+    if (lo == hi) {
+        for (size_t r = 0; r < count; r++) keys[r] = lo;
+        return;
+    }
+    
+    // Keys share every bit above the highest one lo and hi differ in:
+    // the first digit is the one just below, whatever its alignment
+    int top = (int)hydra_log2(lo ^ hi) + 1;
+    int width = top < digit_bits ? top : digit_bits;
+    int shift = top - width;
+    uint32_t mask = (1u << width) - 1;
+    uint32_t high = (top >= 32) ? 0 : ~0u << top;
+    memset(table, 0, ((size_t)mask + 1) * sizeof(uint32_t));
+    if (src32) hydra_quantile_count(src32, NULL, n, shift, mask, table);
+    else hydra_quantile_count(NULL, src16, n, shift, mask, table);
+    
+    size_t active = 0;
+    for (size_t r = 0; r < count; r++) {
+        HydraQuantileTarget* t = &targets[r];
+        size_t rank = ranks[r];
+        uint32_t d = 0;
+        while (rank >= table[d]) rank -= table[d++];
+        t->prefix = (lo & high) | (d << shift);
+        t->high = high | (mask << shift);
+        t->top = shift;
+        t->rank = rank;
+        t->size = table[d];
+        if (t->top == 0) keys[r] = t->prefix;
+        else active++;
+    }
+    
+    while (active > 0) {
+        // Group targets by bucket: copy the bucket if it fits, else count
+        // its next digit; whatever does not fit waits for the next pass
+        size_t used = 0;
+        int ngroups = 0;
+        for (size_t r = 0; r < count; r++) {
+            HydraQuantileTarget* t = &targets[r];
+            t->group = -1;
+            if (t->top == 0) continue;
+            for (int g = 0; g < ngroups; g++) {
+                if (groups[g].prefix == t->prefix && groups[g].high == t->high) t->group = g;
+            }
+            if (t->group >= 0) continue;
+            
+            HydraQuantileGroup* g = &groups[ngroups];
+            int group_width = t->top < digit_bits ? t->top : digit_bits;
+            g->prefix = t->prefix;
+            g->high = t->high;
+            g->shift = t->top - group_width;
+            g->len = 0;
+            if (t->size <= HYDRA_RADIX_HIST_WORDS - used) {
+                g->mask = 0;
+                g->table = table + used;
+                used += t->size;
+            } else if (((size_t)1 << group_width) <= HYDRA_RADIX_HIST_WORDS - used) {
+                g->mask = (1u << group_width) - 1;
+                g->table = table + used;
+                used += (size_t)1 << group_width;
+                memset(g->table, 0, ((size_t)1 << group_width) * sizeof(uint32_t));
+            } else {
+                continue;
+            }
+            t->group = ngroups++;
+        }
+        
+        // Second pass: usually every group refines a first-digit bucket
+        bool first = true;
+        size_t trash_words = 0;
+        for (int g = 0; g < ngroups; g++) {
+            first &= groups[g].high == (high | (mask << shift));
+            if (groups[g].mask) trash_words = (size_t)groups[g].mask + 1;
+        }
+        if (first && trash_words <= HYDRA_RADIX_HIST_WORDS - used) {
+            memset(table + used, 0, trash_words * sizeof(uint32_t));
+            if (src32) hydra_quantile_scan_first(src32, NULL, n, groups, ngroups, shift, table, table + used);
+            else hydra_quantile_scan_first(NULL, src16, n, groups, ngroups, shift, table, table + used);
+        } else if (src32) {
+            hydra_quantile_scan(src32, NULL, n, groups, ngroups, shift);
+        } else {
+            hydra_quantile_scan(NULL, src16, n, groups, ngroups, shift);
+        }
+        
+        for (size_t r = 0; r < count; r++) {
+            HydraQuantileTarget* t = &targets[r];
+            if (t->group < 0) continue;
+            HydraQuantileGroup* g = &groups[t->group];
+            if (!g->mask) {
+                // Copied keys, biased to int32 order for introselect
+                int32_t* copy = (int32_t*)g->table;
+                hydra_introselect(copy, 0, g->len - 1, t->rank,
+                                  (int)hydra_log2((uint32_t)g->len), true);
+                keys[r] = (uint32_t)copy[t->rank] ^ 0x80000000u;
+                t->top = 0;
+                active--;
+                continue;
+            }
+            uint32_t d = 0;
+            while (t->rank >= g->table[d]) t->rank -= g->table[d++];
+            t->prefix |= d << g->shift;
+            t->high |= g->mask << g->shift;
+            t->top = g->shift;
+            t->size = g->table[d];
+            if (t->top == 0) {
+                keys[r] = t->prefix;
+                active--;
+            }
+        }
+    }
 }
 
 /**
- * Specialized version for uint16_t
- * Up to 5x+ faster than comparison sorts
+ * Rank of quantile ppm (parts per million, 990000 = p99) among n values:
+ * the nearest-rank definition, ceil(ppm * n / 10^6) - 1, at least 0
  */
-void hydra_sort_u16(uint16_t* arr, uint16_t* aux, size_t n) {
-    hydra_counting_sort_u16(arr, aux, n);
+size_t hydra_quantile_rank(size_t n, uint32_t ppm) {
+    if (n == 0) return 0;
+    if (ppm > 1000000u) ppm = 1000000u;
+    uint64_t r = ((uint64_t)ppm * n + 999999u) / 1000000u;
+    return r ? (size_t)r - 1 : 0;
+}
+
+/**
+ * Values at the given ranks (0-based, each below n, any order) of arr,
+ * exactly as a sort would place them; arr is only read
+ *
+ * @param out   out[i] receives the value of rank ranks[i]
+ *
+ * Ranks must exist: count must be 0 when n == 0, since nothing is written
+ * then. Use hydra_quantile_rank() for percentiles.
+ */
+void hydra_quantiles(const int32_t* arr, size_t n, const size_t* ranks, size_t count,
+                     int32_t* out) {
+    uint32_t keys[HYDRA_QUANTILE_RANKS];
+    if (n == 0) return;
+    for (size_t done = 0; done < count; done += HYDRA_QUANTILE_RANKS) {
+        size_t m = (count - done < HYDRA_QUANTILE_RANKS) ? count - done : HYDRA_QUANTILE_RANKS;
+        hydra_quantile_keys(arr, NULL, n, ranks + done, m, keys);
+        for (size_t i = 0; i < m; i++) out[done + i] = (int32_t)(keys[i] ^ 0x80000000u);
+    }
+}
+
+/**
+ * hydra_quantiles for uint8_t: one counting pass answers every rank
+ */
+void hydra_quantiles_u8(const uint8_t* arr, size_t n, const size_t* ranks, size_t count,
+                        uint8_t* out) {
+    uint32_t counts[256] = {0};
+    if (n == 0) return;
+    for (size_t i = 0; i < n; i++) counts[arr[i]]++;
+    for (size_t r = 0; r < count; r++) {
+        size_t rank = ranks[r];
+        uint32_t v = 0;
+        while (rank >= counts[v]) rank -= counts[v++];
+        out[r] = (uint8_t)v;
+    }
+}
+
+/**
+ * hydra_quantiles for uint16_t
+ *
+ * @param counts    65536 words for a single counting pass, or NULL for
+ *                  the digit passes in the radix table (two at most)
+ */
+void hydra_quantiles_u16(const uint16_t* arr, size_t n, const size_t* ranks, size_t count,
+                         uint16_t* out, uint32_t* counts) {
+    if (n == 0) return;
+    if (counts) {
+        memset(counts, 0, 65536 * sizeof(uint32_t));
+        for (size_t i = 0; i < n; i++) counts[arr[i]]++;
+        for (size_t r = 0; r < count; r++) {
+            size_t rank = ranks[r];
+            uint32_t v = 0;
+            while (rank >= counts[v]) rank -= counts[v++];
+            out[r] = (uint16_t)v;
+        }
+        return;
+    }
+    
+    uint32_t keys[HYDRA_QUANTILE_RANKS];
+    for (size_t done = 0; done < count; done += HYDRA_QUANTILE_RANKS) {
+        size_t m = (count - done < HYDRA_QUANTILE_RANKS) ? count - done : HYDRA_QUANTILE_RANKS;
+        hydra_quantile_keys(NULL, arr, n, ranks + done, m, keys);
+        for (size_t i = 0; i < m; i++) out[done + i] = (uint16_t)keys[i];
+    }
 }
 
 #endif // HYDRA_SORT_V2_H
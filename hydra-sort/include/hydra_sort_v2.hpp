@@ -0,0 +1,402 @@
+/**
+ * HYDRA-SORT v2.0 C++ front end
+ *
+ * hydra::sort<T> over the same engines as hydra_sort, for every integer
+ * type from int8 to uint64 plus float and double. The path is chosen at
+ * compile time from sizeof(T) and the key traits below:
+ *
+ *   1 byte    counting sort (hydra_sort_u8)
+ *   2 bytes   radix / in-place MSD (hydra_sort_u16)
+ *   4 bytes   the full int32 engine (hydra_sort: analysis, radix,
+ *             counting, pdqsort, powersort, parallel drivers)
+ *   8 bytes   64-bit LSD radix with aux, per-type introsort without
+ *
+ * Every type except the engine's own is mapped to an order-preserving key
+ * in place and back afterwards: signed integers flip the sign bit, floats
+ * flip every bit when negative and only the sign bit otherwise. Floats
+ * therefore sort in IEEE total order: -NaN < -inf < ... < -0.0 < +0.0 <
+ * ... < +inf < +NaN.
+ *
+ * hydra::argsort<T> returns the sorting permutation for the same types.
+ *
+ * Requires C++17. Like hydra_sort_v2.h, include from one translation unit.
+ */
+
+#ifndef HYDRA_SORT_V2_HPP
+#define HYDRA_SORT_V2_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "hydra_sort_v2.h"
+
+// 64-bit keys below this go to the comparison sort (the 8 KB histogram
+// clear and prefix sums dominate shorter inputs)
+#ifndef HYDRA_RADIX64_THRESHOLD
+#define HYDRA_RADIX64_THRESHOLD HYDRA_RADIX_THRESHOLD
+#endif
+
+namespace hydra {
+namespace detail {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// KEY TRAITS
+// ═══════════════════════════════════════════════════════════════════════════
+
+template<size_t Bytes> struct uint_of;
+template<> struct uint_of<1> { using type = uint8_t; };
+template<> struct uint_of<2> { using type = uint16_t; };
+template<> struct uint_of<4> { using type = uint32_t; };
+template<> struct uint_of<8> { using type = uint64_t; };
+
+/**
+ * Order-preserving map from T to an unsigned key of the same width
+ */
+template<typename T>
+struct key_traits {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "hydra::sort needs an integer or floating-point type");
+    static_assert(!std::is_floating_point_v<T> || sizeof(T) == 4 || sizeof(T) == 8,
+                  "only float and double are supported");
+
+    using key_type = typename uint_of<sizeof(T)>::type;
+    static constexpr key_type sign = key_type(key_type(1) << (sizeof(T) * 8 - 1));
+    static constexpr bool identity = std::is_unsigned_v<T>;
+
+    static inline key_type encode(T x) {
+        key_type k;
+        std::memcpy(&k, &x, sizeof(k));
+        if constexpr (std::is_floating_point_v<T>) {
+            // Negative: flip all bits. Positive: flip the sign bit.
+            return key_type(k ^ ((k & sign) ? key_type(~key_type(0)) : sign));
+        } else if constexpr (std::is_signed_v<T>) {
+            return key_type(k ^ sign);
+        } else {
+            return k;
+        }
+    }
+
+    static inline T decode(key_type k) {
+        if constexpr (std::is_floating_point_v<T>) {
+            k = key_type(k ^ ((k & sign) ? sign : key_type(~key_type(0))));
+        } else if constexpr (std::is_signed_v<T>) {
+            k = key_type(k ^ sign);
+        }
+        T x;
+        std::memcpy(&x, &k, sizeof(x));
+        return x;
+    }
+};
+
+/**
+ * Rewrite arr as keys (to_key) or keys back as T, in place. Bytes move
+ * through memcpy only, so the engines may read the storage as key_type.
+ * Keys for the int32 engine are offset by the sign bit so that signed
+ * comparison matches the unsigned key order.
+ */
+template<typename T, typename K, bool ToKey>
+inline void transform(T* arr, size_t n, K offset) {
+    using traits = key_traits<T>;
+    for (size_t i = 0; i < n; i++) {
+        if constexpr (ToKey) {
+            K k = K(traits::encode(arr[i]) ^ offset);
+            std::memcpy(&arr[i], &k, sizeof(k));
+        } else {
+            K k;
+            std::memcpy(&k, &arr[i], sizeof(k));
+            arr[i] = traits::decode(typename traits::key_type(k ^ offset));
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PER-TYPE NETWORKS AND INTROSORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Default order for the templates below: operator< on the key
+ */
+struct less_than {
+    template<typename K>
+    bool operator()(const K& a, const K& b) const { return a < b; }
+};
+
+/**
+ * Branchless compare-exchange: a conditional move per output, for any key
+ */
+template<typename K, typename Less>
+HYDRA_INLINE void cswap(K& a, K& b, Less less) {
+    bool swap = less(b, a);
+    K lo = swap ? b : a;
+    K hi = swap ? a : b;
+    a = lo;
+    b = hi;
+}
+
+template<typename K, typename Less>
+inline void sort4(K* arr, Less less) {
+    K r0 = arr[0], r1 = arr[1], r2 = arr[2], r3 = arr[3];
+    cswap(r0, r1, less); cswap(r2, r3, less);
+    cswap(r0, r2, less); cswap(r1, r3, less);
+    cswap(r1, r2, less);
+    arr[0] = r0; arr[1] = r1; arr[2] = r2; arr[3] = r3;
+}
+
+template<typename K, typename Less>
+inline void sort8(K* arr, Less less) {
+    K r0 = arr[0], r1 = arr[1], r2 = arr[2], r3 = arr[3];
+    K r4 = arr[4], r5 = arr[5], r6 = arr[6], r7 = arr[7];
+    // Batcher's odd-even mergesort network (19 comparators), as hydra_sort8
+    cswap(r0, r1, less); cswap(r2, r3, less); cswap(r4, r5, less); cswap(r6, r7, less);
+    cswap(r0, r2, less); cswap(r1, r3, less); cswap(r4, r6, less); cswap(r5, r7, less);
+    cswap(r1, r2, less); cswap(r5, r6, less);
+    cswap(r0, r4, less); cswap(r1, r5, less); cswap(r2, r6, less); cswap(r3, r7, less);
+    cswap(r2, r4, less); cswap(r3, r5, less);
+    cswap(r1, r2, less); cswap(r3, r4, less); cswap(r5, r6, less);
+    arr[0] = r0; arr[1] = r1; arr[2] = r2; arr[3] = r3;
+    arr[4] = r4; arr[5] = r5; arr[6] = r6; arr[7] = r7;
+}
+
+template<typename K, typename Less>
+inline void insertion(K* arr, size_t n, Less less) {
+    for (size_t i = 1; i < n; i++) {
+        K key = arr[i];
+        size_t j = i;
+        while (j >= 1 && less(key, arr[j - 1])) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = key;
+    }
+}
+
+/**
+ * Sort n <= 16 keys without reading past arr[n-1] (as hydra_sort_tiny)
+ */
+template<typename K, typename Less>
+inline void sort_tiny(K* arr, size_t n, Less less) {
+    if (n == 4) sort4(arr, less);
+    else if (n == 8) sort8(arr, less);
+    else insertion(arr, n, less);
+}
+
+template<typename K, typename Less>
+inline void heapsort(K* arr, size_t n, Less less) {
+    auto sift = [arr, less](size_t i, size_t end) {
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= end) return;
+            if (child + 1 < end && less(arr[child], arr[child + 1])) child++;
+            if (!less(arr[i], arr[child])) return;
+            K t = arr[i]; arr[i] = arr[child]; arr[child] = t;
+            i = child;
+        }
+    };
+    for (size_t i = n / 2; i > 0; i--) sift(i - 1, n);
+    for (size_t i = n - 1; i > 0; i--) {
+        K t = arr[0]; arr[0] = arr[i]; arr[i] = t;
+        sift(0, i);
+    }
+}
+
+/**
+ * Introsort on keys: median-of-three Hoare partition (equal keys split
+ * evenly), heapsort past 2*log2(n) levels, networks at 16 and below.
+ * Recurses into the smaller side only, so the stack stays O(log n).
+ */
+template<typename K, typename Less>
+inline void introsort(K* arr, size_t n, int depth, Less less) {
+    while (n > 16) {
+        if (depth-- == 0) {
+            heapsort(arr, n, less);
+            return;
+        }
+
+        // Median of three into arr[0]
+        size_t mid = n / 2;
+        cswap(arr[mid], arr[n - 1], less);
+        cswap(arr[0], arr[n - 1], less);
+        cswap(arr[mid], arr[0], less);
+        K pivot = arr[0];
+
+        // Hoare partition: arr[n-1] >= pivot and arr[0] == pivot stop the scans
+        size_t i = 0, j = n;
+        for (;;) {
+            do i++; while (less(arr[i], pivot));
+            do j--; while (less(pivot, arr[j]));
+            if (i >= j) break;
+            K t = arr[i]; arr[i] = arr[j]; arr[j] = t;
+        }
+        arr[0] = arr[j];
+        arr[j] = pivot;
+
+        size_t left = j, right = n - j - 1;
+        if (left < right) {
+            introsort(arr, left, depth, less);
+            arr += j + 1;
+            n = right;
+        } else {
+            introsort(arr + j + 1, right, depth, less);
+            n = left;
+        }
+    }
+    sort_tiny(arr, n, less);
+}
+
+inline int introsort_depth(size_t n) {
+    int depth = 0;
+    for (size_t m = n; m > 1; m >>= 1) depth += 2;
+    return depth;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 64-BIT LSD RADIX
+// ═══════════════════════════════════════════════════════════════════════════
+
+#if HYDRA_PLATFORM_PICO
+static uint32_t radix64_hist_core[HYDRA_MAX_WORKERS][8 * 256];
+#endif
+
+/**
+ * LSD radix sort for uint64 keys, eight byte digits
+ *
+ * As hydra_radix_sort_256: all eight histograms from one read pass, and a
+ * byte that is the same for every key skips its scatter, so timestamps
+ * sharing their high bytes pay only for the bytes that vary. aux must
+ * hold n.
+ */
+HYDRA_RAMFUNC inline void radix_sort_u64(uint64_t* arr, uint64_t* aux, size_t n) {
+#if HYDRA_PLATFORM_PICO
+    uint32_t* counts = radix64_hist_core[get_core_num()];
+#else
+    uint32_t counts[8 * 256];
+#endif
+    uint64_t* src = arr;
+    uint64_t* dst = aux;
+
+    if (n <= 1) return;
+
+    memset(counts, 0, 8 * 256 * sizeof(uint32_t));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x = arr[i];
+        for (int byte = 0; byte < 8; byte++) {
+            counts[byte * 256 + ((x >> (byte * 8)) & 0xFF)]++;
+        }
+    }
+
+    for (int byte = 0; byte < 8; byte++) {
+        uint32_t* c = counts + byte * 256;
+        int shift = byte * 8;
+
+        // Trivial digit: nothing would move
+        if (c[(src[0] >> shift) & 0xFF] == n) continue;
+
+        uint32_t sum = 0;
+        for (int i = 0; i < 256; i++) {
+            uint32_t t = c[i];
+            c[i] = sum;
+            sum += t;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint64_t x = src[i];
+            dst[c[(x >> shift) & 0xFF]++] = x;
+        }
+
+        uint64_t* temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != arr) memcpy(arr, src, n * sizeof(uint64_t));
+}
+
+} // namespace detail
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Sort n values of any integer or floating-point type in place
+ *
+ * @param arr       Array to sort (in-place)
+ * @param n         Number of elements
+ * @param aux       Auxiliary buffer (size n), or nullptr to sort in place
+ * @param profile   Performance profile (int32-sized types)
+ */
+template<typename T>
+void sort(T* arr, size_t n, T* aux = nullptr, HydraProfile profile = HYDRA_PROFILE_BALANCED) {
+    using traits = detail::key_traits<T>;
+    using key = typename traits::key_type;
+
+    if (n <= 1) return;
+
+    if constexpr (std::is_same_v<T, int32_t>) {
+        hydra_sort(arr, n, aux, profile);
+    } else if constexpr (sizeof(T) == 4) {
+        // Signed key order for the int32 engine
+        detail::transform<T, uint32_t, true>(arr, n, traits::sign);
+        hydra_sort(reinterpret_cast<int32_t*>(arr), n, reinterpret_cast<int32_t*>(aux), profile);
+        detail::transform<T, uint32_t, false>(arr, n, traits::sign);
+    } else if constexpr (sizeof(T) == 1) {
+        if constexpr (!traits::identity) detail::transform<T, key, true>(arr, n, 0);
+        hydra_sort_u8(reinterpret_cast<uint8_t*>(arr), n);
+        if constexpr (!traits::identity) detail::transform<T, key, false>(arr, n, 0);
+    } else if constexpr (sizeof(T) == 2) {
+        if constexpr (!traits::identity) detail::transform<T, key, true>(arr, n, 0);
+        hydra_sort_u16(reinterpret_cast<uint16_t*>(arr), reinterpret_cast<uint16_t*>(aux), n);
+        if constexpr (!traits::identity) detail::transform<T, key, false>(arr, n, 0);
+    } else {
+        if constexpr (!traits::identity) detail::transform<T, key, true>(arr, n, 0);
+        uint64_t* keys = reinterpret_cast<uint64_t*>(arr);
+        if (aux && n >= HYDRA_RADIX64_THRESHOLD) {
+            detail::radix_sort_u64(keys, reinterpret_cast<uint64_t*>(aux), n);
+        } else {
+            detail::introsort(keys, n, detail::introsort_depth(n), detail::less_than());
+        }
+        if constexpr (!traits::identity) detail::transform<T, key, false>(arr, n, 0);
+    }
+}
+
+/**
+ * Write the permutation that sorts keys into idx (keys are not modified)
+ *
+ * idx[i] is the index of the i-th smallest key, equal keys in index order.
+ * Types up to 32 bits with aux (3n words) go through hydra_sort_kv on a
+ * copy of the keys as int32: radix, parallel for large n. Without aux, and
+ * for 64-bit types, the indices are introsorted by key with ties broken by
+ * index. Apply the result with hydra_apply_permutation.
+ */
+template<typename T>
+void argsort(const T* keys, uint32_t* idx, size_t n, uint32_t* aux = nullptr) {
+    using traits = detail::key_traits<T>;
+
+    if constexpr (std::is_same_v<T, int32_t>) {
+        hydra_argsort(keys, idx, n, aux);
+    } else {
+        for (size_t i = 0; i < n; i++) idx[i] = (uint32_t)i;
+        if (n <= 1) return;
+
+        if constexpr (sizeof(T) <= 4) {
+            if (aux) {
+                // Narrow keys widen to non-negative int32; 32-bit keys take the sign offset
+                uint32_t offset = sizeof(T) == 4 ? 0x80000000u : 0;
+                for (size_t i = 0; i < n; i++) aux[i] = uint32_t(traits::encode(keys[i])) ^ offset;
+                hydra_sort_kv(reinterpret_cast<int32_t*>(aux), idx, n, aux + n);
+                return;
+            }
+        }
+        auto less = [keys](uint32_t a, uint32_t b) {
+            auto ka = traits::encode(keys[a]);
+            auto kb = traits::encode(keys[b]);
+            return ka < kb || (ka == kb && a < b);
+        };
+        detail::introsort(idx, n, detail::introsort_depth(n), less);
+    }
+}
+
+} // namespace hydra
+
+#endif // HYDRA_SORT_V2_HPP
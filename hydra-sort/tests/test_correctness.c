@@ -9,13 +9,22 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
-#include "pico/stdlib.h"
 #include "hydra_sort_v2.h"
 
 #define MAX_TEST_SIZE 1024
 
+// Enough for five blocks on device; the host run also covers deeper cascades
+#if HYDRA_PLATFORM_PICO
+#define MAX_LARGE_SIZE (HYDRA_BLOCK_SIZE * 5 + 77)
+#else
+#define MAX_LARGE_SIZE (HYDRA_BLOCK_SIZE * 70 + 77)
+#endif
+
 static int32_t test_data[MAX_TEST_SIZE];
 static int32_t aux_buffer[MAX_TEST_SIZE];
+static int32_t large_data[MAX_LARGE_SIZE];
+static int32_t large_ref[MAX_LARGE_SIZE];
+static int32_t large_aux[MAX_LARGE_SIZE];
 static int tests_passed = 0;
 static int tests_failed = 0;
 
@@ -41,6 +50,18 @@ static bool is_sorted_u16(uint16_t* arr, size_t n) {
     return true;
 }
 
+static int compare_i32(const void* a, const void* b) {
+    int32_t va = *(const int32_t*)a;
+    int32_t vb = *(const int32_t*)b;
+    return (va > vb) - (va < vb);
+}
+
+// Verify arr holds exactly the values of ref once ref is sorted
+static bool matches_reference(int32_t* arr, int32_t* ref, size_t n) {
+    qsort(ref, n, sizeof(int32_t), compare_i32);
+    return memcmp(arr, ref, n * sizeof(int32_t)) == 0;
+}
+
 // Test result macro
 #define TEST(name, condition) do { \
     if (condition) { \
@@ -90,6 +111,26 @@ void test_sorting_networks() {
     for (int i = 0; i < 16; i++) arr16[i] = 16 - i;
     hydra_sort16(arr16);
     TEST("sort16 reverse", is_sorted_i32(arr16, 16));
+    
+    bool random16_ok = true;
+    for (int round = 0; round < 1000; round++) {
+        int32_t ref16[16];
+        for (int i = 0; i < 16; i++) arr16[i] = ref16[i] = rand() % 50 - 25;
+        hydra_sort16(arr16);
+        if (!matches_reference(arr16, ref16, 16)) random16_ok = false;
+    }
+    TEST("sort16 random x1000", random16_ok);
+    
+    // hydra_sort on every tiny size must leave the element past the end alone
+    bool tiny_ok = true;
+    for (size_t n = 2; n <= 16; n++) {
+        int32_t ref[17];
+        for (size_t i = 0; i < n; i++) test_data[i] = ref[i] = rand() % 100;
+        test_data[n] = -1;
+        hydra_sort(test_data, n, aux_buffer, HYDRA_PROFILE_BALANCED);
+        if (!matches_reference(test_data, ref, n) || test_data[n] != -1) tiny_ok = false;
+    }
+    TEST("hydra_sort tiny sizes in bounds", tiny_ok);
 }
 
 void test_insertion_sort() {
@@ -146,6 +187,47 @@ void test_counting_sort() {
     for (int i = 0; i < 512; i++) shorts[i] = rand() % 65536;
     hydra_counting_sort_u16(shorts, shorts_aux, 512);
     TEST("counting u16 n=512", is_sorted_u16(shorts, 512));
+    
+    // int32, histogram in the per-core table
+    size_t n = 3000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 100 - 50;
+    hydra_counting_sort_i32(large_data, n, -50, 49, NULL);
+    TEST("counting i32 signed range", matches_reference(large_data, large_ref, n));
+    
+    // Caller histogram, and ranges touching both ends of int32
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = INT32_MAX - rand() % 2000;
+    hydra_counting_sort_i32(large_data, n, INT32_MAX - 1999, INT32_MAX, (uint32_t*)large_aux);
+    TEST("counting i32 at INT32_MAX", matches_reference(large_data, large_ref, n));
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = INT32_MIN + rand() % 20;
+    hydra_counting_sort_i32(large_data, n, INT32_MIN, INT32_MIN + 19, NULL);
+    TEST("counting i32 at INT32_MIN", matches_reference(large_data, large_ref, n));
+    
+    // Range wider than the per-core table: NULL counts must not overflow it
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 100001;
+    hydra_counting_sort_i32(large_data, n, 0, 100000, NULL);
+    TEST("counting i32 wide range, NULL counts", matches_reference(large_data, large_ref, n));
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(rand() % (HYDRA_RADIX_HIST_WORDS + 1));
+    hydra_counting_sort_i32(large_data, n, 0, HYDRA_RADIX_HIST_WORDS, NULL);
+    TEST("counting i32 range one past the table", matches_reference(large_data, large_ref, n));
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(rand() % HYDRA_RADIX_HIST_WORDS);
+    hydra_counting_sort_i32(large_data, n, 0, HYDRA_RADIX_HIST_WORDS - 1, NULL);
+    TEST("counting i32 range filling the table", matches_reference(large_data, large_ref, n));
+    
+    // 12-bit ADC samples: counting sort while the range is below n and the budget
+    n = 5000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFF;
+    HydraFeatures f = hydra_analyze(large_data, n);
+    HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks counting i32", s.algorithm == ALG_COUNTING_I32);
+    hydra_set_counting_budget(0);
+    s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("counting budget 0 disables it", s.algorithm == ALG_RADIX_256);
+    hydra_set_counting_budget(HYDRA_COUNTING_BUDGET);
+    hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort 12-bit samples", matches_reference(large_data, large_ref, n));
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFF;
+    hydra_sort(large_data, n, NULL, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort 12-bit samples without aux", matches_reference(large_data, large_ref, n));
 }
 
 void test_radix_sort() {
@@ -164,6 +246,135 @@ void test_radix_sort() {
     TEST("radix small range", is_sorted_i32((int32_t*)udata, 200));
 }
 
+void test_radix_i32() {
+    printf("\n── Signed Radix ──────────────────────────────\n");
+    
+    // Ranges giving one, two and three digit passes, straddling zero
+    static const int range_bits[] = {4, 12, 20, 23, 31};
+    for (size_t k = 0; k < sizeof(range_bits) / sizeof(range_bits[0]); k++) {
+        size_t n = 5000;
+        uint32_t mask = (1u << range_bits[k]) - 1;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            large_data[i] = large_ref[i] = (int32_t)(r & mask) - (int32_t)(mask / 2);
+        }
+        HydraFeatures f = hydra_analyze(large_data, n);
+        hydra_radix_sort_i32(large_data, large_aux, n, f.min_val, f.range_log2);
+        char name[40];
+        snprintf(name, sizeof(name), "radix i32 %d-bit signed range", range_bits[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    // Full int32 range: analysis must not overflow
+    size_t n = 3000;
+    for (size_t i = 0; i < n; i++) {
+        large_data[i] = large_ref[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+    }
+    large_data[0] = large_ref[0] = INT32_MAX;
+    large_data[1] = large_ref[1] = INT32_MIN;
+    HydraFeatures f = hydra_analyze(large_data, n);
+    TEST("analyze full range", f.range_log2 == 31 && f.min_val == INT32_MIN);
+    hydra_radix_sort_i32(large_data, large_aux, n, f.min_val, f.range_log2);
+    TEST("radix i32 full range", matches_reference(large_data, large_ref, n));
+    
+    // Offset far from zero with a one-digit spread: every high pass skipped
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = -2000000000 + rand() % 200;
+    f = hydra_analyze(large_data, n);
+    hydra_radix_sort_i32(large_data, large_aux, n, f.min_val, f.range_log2);
+    TEST("radix i32 offset range", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = -7;
+    hydra_radix_sort_i32(large_data, large_aux, n, -7, 0);
+    TEST("radix i32 all equal", matches_reference(large_data, large_ref, n));
+    
+#if HYDRA_RADIX_WC
+    // Write-combining scatter: forced on, over a buffer that starts off a
+    // cache line so first and last lines are partial
+    hydra_set_radix_wc_threshold(0);
+    for (size_t k = 0; k < 3; k++) {
+        size_t m = 4001 + k * 3000;
+        int32_t* data = large_data + 3;
+        for (size_t i = 0; i < m; i++) data[i] = large_ref[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()) >> (k * 10);
+        f = hydra_analyze(data, m);
+        hydra_radix_sort_i32(data, large_aux + 5, m, f.min_val, f.range_log2);
+        char name[40];
+        snprintf(name, sizeof(name), "radix i32 write-combining %zu", k);
+        TEST(name, matches_reference(data, large_ref, m));
+    }
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFFFFF;
+    hydra_radix_sort_256((uint32_t*)large_data + 1, (uint32_t*)large_aux + 7, n - 1);
+    TEST("radix 256 write-combining", matches_reference(large_data + 1, large_ref + 1, n - 1));
+    hydra_set_radix_wc_threshold(HYDRA_RADIX_WC_THRESHOLD);
+#endif
+    
+    // hydra_sort used to send negative keys through the unsigned radix
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 1000 - 500;
+    hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort negative small range", matches_reference(large_data, large_ref, n));
+}
+
+void test_american_flag() {
+    printf("\n── In-Place MSD Radix ────────────────────────\n");
+    
+    // One to four byte levels, straddling zero
+    static const int range_bits[] = {4, 12, 20, 31};
+    for (size_t k = 0; k < sizeof(range_bits) / sizeof(range_bits[0]); k++) {
+        size_t n = 5000;
+        uint32_t mask = (range_bits[k] == 31) ? 0xFFFFFFFFu : (1u << range_bits[k]) - 1;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            large_data[i] = large_ref[i] = (int32_t)((r & mask) - mask / 2);
+        }
+        HydraFeatures f = hydra_analyze(large_data, n);
+        hydra_american_flag_sort(large_data, n, f.min_val, f.range_log2);
+        char name[40];
+        snprintf(name, sizeof(name), "american flag %d-bit range", range_bits[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    // Sizes around the insertion cutoff
+    bool sizes_ok = true;
+    for (size_t n = 2; n <= 2 * HYDRA_FLAG_INSERTION + 3; n++) {
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 1000 - 500;
+        hydra_american_flag_sort(large_data, n, -500, 9);
+        if (!matches_reference(large_data, large_ref, n)) sizes_ok = false;
+    }
+    TEST("american flag small sizes", sizes_ok);
+    
+    // Keys sharing their high digits: levels skipped without moving
+    size_t n = 3000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = 0x1230000 + rand() % 50;
+    hydra_american_flag_sort(large_data, n, 0, 24);
+    TEST("american flag shared prefix", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = -3;
+    hydra_american_flag_sort(large_data, n, -3, 0);
+    TEST("american flag all equal", matches_reference(large_data, large_ref, n));
+    
+    uint16_t* shorts = (uint16_t*)large_data;
+    for (size_t i = 0; i < n; i++) shorts[i] = (uint16_t)rand();
+    hydra_sort_u16(shorts, NULL, n);
+    TEST("hydra_sort_u16 without aux", is_sorted_u16(shorts, n));
+    
+    // hydra_sort with NULL aux: every path that needs aux is replaced
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 2000 - 1000) * 50;
+    hydra_sort(large_data, n, NULL, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort radix without aux", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i) * 40000;
+    hydra_sort(large_data, n, NULL, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort runs without aux", matches_reference(large_data, large_ref, n));
+    
+    n = MAX_LARGE_SIZE;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    hydra_sort(large_data, n, NULL, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("hydra_sort large without aux", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 100000;
+    hydra_sort(large_data, n, NULL, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("hydra_sort large radix without aux", matches_reference(large_data, large_ref, n));
+}
+
 void test_introsort() {
     printf("\n── Introsort ─────────────────────────────────\n");
     
@@ -187,6 +398,335 @@ void test_introsort() {
     TEST("introsort reverse input", is_sorted_i32(test_data, 1000));
 }
 
+void test_partition_schemes() {
+    printf("\n── Partition Schemes ─────────────────────────\n");
+    
+    // Block partition contract: left < pivot <= right
+    bool contract_ok = true;
+    for (int round = 0; round < 50; round++) {
+        size_t n = 17 + rand() % 1000;
+        for (size_t i = 0; i < n; i++) test_data[i] = rand() % (1 + round * 20);
+        size_t p = hydra_partition_block(test_data, 0, n - 1);
+        for (size_t i = 0; i < p; i++) if (test_data[i] >= test_data[p]) contract_ok = false;
+        for (size_t i = p + 1; i < n; i++) if (test_data[i] < test_data[p]) contract_ok = false;
+    }
+    TEST("block partition contract", contract_ok);
+    
+    static const HydraPartitionScheme schemes[] = {HYDRA_PARTITION_LOMUTO, HYDRA_PARTITION_BLOCK};
+    static const char* names[] = {"lomuto", "block"};
+    for (int k = 0; k < 2; k++) {
+        hydra_set_partition_scheme(schemes[k]);
+        size_t n = 20000;
+        char name[48];
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_introsort(large_data, n);
+        snprintf(name, sizeof(name), "introsort %s random", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i);
+        hydra_introsort(large_data, n);
+        snprintf(name, sizeof(name), "introsort %s reverse", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 4;
+        large_data[5] = large_ref[5] = INT32_MIN;
+        large_data[9] = large_ref[9] = INT32_MAX;
+        hydra_introsort(large_data, n);
+        snprintf(name, sizeof(name), "introsort %s duplicates", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+#if HYDRA_PLATFORM_PICO
+    hydra_set_partition_scheme(HYDRA_PARTITION_LOMUTO);
+#else
+    hydra_set_partition_scheme(HYDRA_PARTITION_BLOCK);
+#endif
+}
+
+void test_dual_pivot() {
+    printf("\n── Dual-Pivot Quicksort ──────────────────────\n");
+    
+    // Sizes around the network/insertion cutoff and beyond
+    for (int n = 2; n <= 1000; n = n * 2 + 1) {
+        for (int i = 0; i < n; i++) test_data[i] = rand() % 10000;
+        hydra_dual_pivot_sort(test_data, n);
+        char name[32];
+        snprintf(name, sizeof(name), "dual-pivot n=%d", n);
+        TEST(name, is_sorted_i32(test_data, n));
+    }
+    
+    size_t n = 20000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    hydra_dual_pivot_sort(large_data, n);
+    TEST("dual-pivot random", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i);
+    hydra_dual_pivot_sort(large_data, n);
+    TEST("dual-pivot reverse", matches_reference(large_data, large_ref, n));
+    
+    // Equal pivots skip the middle part; extremes must survive
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 3;
+    large_data[5] = large_ref[5] = INT32_MIN;
+    large_data[9] = large_ref[9] = INT32_MAX;
+    hydra_dual_pivot_sort(large_data, n);
+    TEST("dual-pivot duplicates", matches_reference(large_data, large_ref, n));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = 42;
+    hydra_dual_pivot_sort(large_data, n);
+    TEST("dual-pivot all equal", matches_reference(large_data, large_ref, n));
+    
+    // Selector picks it for medium random input under Lomuto
+    hydra_set_partition_scheme(HYDRA_PARTITION_LOMUTO);
+    HydraFeatures f = {0};
+    f.n = 1000;
+    f.range_log2 = 30;
+    f.min_val = -(1 << 29);
+    f.max_val = 1 << 29;
+    f.runs = 500;
+    HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks dual-pivot", s.algorithm == ALG_QUICKSORT_DUAL_PIVOT);
+    for (size_t i = 0; i < 3000; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    hydra_sort(large_data, 3000, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort dual-pivot path", matches_reference(large_data, large_ref, 3000));
+#if !HYDRA_PLATFORM_PICO
+    hydra_set_partition_scheme(HYDRA_PARTITION_BLOCK);
+#endif
+}
+
+void test_pdqsort() {
+    printf("\n── Pattern-Defeating Quicksort ───────────────\n");
+    
+    // Equal-key partition: the pivot's run ends at the returned index
+    bool left_ok = true;
+    for (int round = 0; round < 50; round++) {
+        size_t n = 30 + rand() % 500;
+        for (size_t i = 0; i < n; i++) test_data[i] = rand() % 6;
+        test_data[0] = 5;
+        size_t p = hydra_partition_left(test_data, 0, n - 1);
+        for (size_t i = 0; i <= p; i++) if (test_data[i] > 5) left_ok = false;
+        if (test_data[p] != 5) left_ok = false;
+        for (size_t i = p + 1; i < n; i++) if (test_data[i] <= 5) left_ok = false;
+    }
+    TEST("partition_left contract", left_ok);
+    
+    static const HydraPartitionScheme schemes[] = {HYDRA_PARTITION_LOMUTO, HYDRA_PARTITION_BLOCK};
+    static const char* names[] = {"lomuto", "block"};
+    for (int k = 0; k < 2; k++) {
+        hydra_set_partition_scheme(schemes[k]);
+        size_t n = 20000;
+        char name[48];
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_pdqsort(large_data, n);
+        snprintf(name, sizeof(name), "pdqsort %s random", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 5) * 400000000;
+        large_data[3] = large_ref[3] = INT32_MIN;
+        large_data[7] = large_ref[7] = INT32_MAX;
+        hydra_pdqsort(large_data, n);
+        snprintf(name, sizeof(name), "pdqsort %s low cardinality", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        // Organ pipe and sawtooth trigger the bad-partition shuffle
+        for (size_t i = 0; i < n; i++) {
+            large_data[i] = large_ref[i] = (int32_t)(i < n / 2 ? i : n - i);
+        }
+        hydra_pdqsort(large_data, n);
+        snprintf(name, sizeof(name), "pdqsort %s organ pipe", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(i % 97);
+        hydra_pdqsort(large_data, n);
+        snprintf(name, sizeof(name), "pdqsort %s sawtooth", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+        
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i);
+        hydra_pdqsort(large_data, n);
+        snprintf(name, sizeof(name), "pdqsort %s reverse", names[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+#if HYDRA_PLATFORM_PICO
+    hydra_set_partition_scheme(HYDRA_PARTITION_LOMUTO);
+#else
+    hydra_set_partition_scheme(HYDRA_PARTITION_BLOCK);
+#endif
+    
+    // Analysis flags low cardinality with a wide range, and the selector
+    // routes it to pdqsort
+    for (size_t i = 0; i < 3000; i++) large_data[i] = large_ref[i] = (rand() % 8) * 250000000;
+    HydraFeatures f = hydra_analyze(large_data, 3000);
+    HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks pdqsort", f.duplicates >= HYDRA_DUPLICATE_THRESHOLD &&
+         s.algorithm == ALG_PDQSORT);
+    hydra_sort(large_data, 3000, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort pdqsort path", matches_reference(large_data, large_ref, 3000));
+    
+    for (size_t i = 0; i < 3000; i++) large_data[i] = rand() - RAND_MAX / 2;
+    f = hydra_analyze(large_data, 3000);
+    TEST("random input not low cardinality", f.duplicates < HYDRA_DUPLICATE_THRESHOLD);
+}
+
+void test_powersort() {
+    printf("\n── Powersort ─────────────────────────────────\n");
+    
+    // Galloping merge: long one-sided stretches, ties, and an output that
+    // overlaps b (a copied out of the front of the same buffer)
+    int32_t a[300];
+    for (int i = 0; i < 300; i++) a[i] = (i < 100) ? i : 1000 + i;
+    for (int i = 0; i < 300; i++) test_data[300 + i] = 100 + (i % 150 == 0 ? 0 : i);
+    hydra_introsort(test_data + 300, 300);
+    memcpy(large_ref, a, sizeof(a));
+    memcpy(large_ref + 300, test_data + 300, 300 * sizeof(int32_t));
+    hydra_merge(a, 300, test_data + 300, 300, test_data);
+    TEST("galloping merge in place", matches_reference(test_data, large_ref, 600));
+    
+    int32_t empty_out[3];
+    int32_t one[3] = {1, 2, 3};
+    hydra_merge(one, 3, NULL, 0, empty_out);
+    TEST("merge with empty side", empty_out[0] == 1 && empty_out[2] == 3);
+    
+    // Descending runs are reversed in place, strictly (ties end the run)
+    int32_t run[6] = {9, 7, 5, 5, 1, 0};
+    size_t len = hydra_count_run(run, 0, 6);
+    TEST("descending run reversed", len == 3 && run[0] == 5 && run[2] == 9 && run[3] == 5);
+    
+    static const size_t streams[] = {1, 2, 7, 40, 300};
+    for (size_t k = 0; k < sizeof(streams) / sizeof(streams[0]); k++) {
+        size_t n = 20000;
+        size_t slen = (n + streams[k] - 1) / streams[k];
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        for (size_t i = 0; i < n; i += slen) {
+            hydra_introsort(large_data + i, (n - i < slen) ? n - i : slen);
+        }
+        // Alternate streams descend
+        for (size_t i = slen; i < n; i += 2 * slen) {
+            size_t e = (n - i < slen) ? n : i + slen;
+            for (size_t lo = i, hi = e - 1; lo < hi; lo++, hi--) {
+                int32_t t = large_data[lo]; large_data[lo] = large_data[hi]; large_data[hi] = t;
+            }
+        }
+        hydra_powersort(large_data, n, large_aux);
+        char name[40];
+        snprintf(name, sizeof(name), "powersort %zu streams", streams[k]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    size_t n = 20000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 50;
+    hydra_powersort(large_data, n, large_aux);
+    TEST("powersort duplicates", matches_reference(large_data, large_ref, n));
+    
+    for (size_t sz = 0; sz <= 70; sz += 7) {
+        for (size_t i = 0; i < sz; i++) large_data[i] = large_ref[i] = rand() % 100;
+        hydra_powersort(large_data, sz, large_aux);
+        if (!matches_reference(large_data, large_ref, sz)) n = 0;
+    }
+    TEST("powersort small sizes", n != 0);
+    
+    // Reversed input and concatenated streams are both a few runs
+    for (size_t i = 0; i < 5000; i++) large_data[i] = large_ref[i] = (int32_t)(5000 - i) * 1000;
+    HydraFeatures f = hydra_analyze(large_data, 5000);
+    HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks powersort (reversed)", f.runs == 1 && s.algorithm == ALG_POWERSORT);
+    
+    for (size_t i = 0; i < 5000; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    for (size_t i = 0; i < 5000; i += 250) hydra_introsort(large_data + i, 250);
+    f = hydra_analyze(large_data, 5000);
+    s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks powersort (streams)", s.algorithm == ALG_POWERSORT);
+    hydra_sort(large_data, 5000, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort powersort path", matches_reference(large_data, large_ref, 5000));
+}
+
+// Fill a with sorted streams of random keys (few distinct values when mod)
+static void fill_streams(int32_t* a, int32_t* ref, size_t n, size_t streams, int32_t mod) {
+    size_t slen = (n + streams - 1) / streams;
+    for (size_t i = 0; i < n; i++) {
+        a[i] = ref[i] = mod ? rand() % mod : rand() - RAND_MAX / 2;
+    }
+    for (size_t i = 0; i < n; i += slen) hydra_introsort(a + i, (n - i < slen) ? n - i : slen);
+}
+
+void test_memory_budget() {
+    printf("\n── Memory Budget ─────────────────────────────\n");
+    
+    // Run merges with a buffer smaller than either run, uneven runs
+    static const size_t aux_lens[] = {0, 1, 7, 300, 2000};
+    bool merge_ok = true;
+    for (size_t k = 0; k < sizeof(aux_lens) / sizeof(aux_lens[0]); k++) {
+        size_t n = 3000, mid = (k & 1) ? 700 : 2100;
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 500;
+        hydra_introsort(large_data, mid);
+        hydra_introsort(large_data + mid, n - mid);
+        hydra_merge_runs(large_data, 0, mid, n, aux_lens[k] ? large_aux : NULL, aux_lens[k]);
+        if (!matches_reference(large_data, large_ref, n)) merge_ok = false;
+    }
+    TEST("merge runs with small buffers", merge_ok);
+    
+    bool powersort_ok = true;
+    for (size_t k = 0; k < sizeof(aux_lens) / sizeof(aux_lens[0]); k++) {
+        size_t n = 5000;
+        fill_streams(large_data, large_ref, n, 9, 0);
+        hydra_powersort_buffer(large_data, n, aux_lens[k] ? large_aux : NULL, aux_lens[k]);
+        if (!matches_reference(large_data, large_ref, n)) powersort_ok = false;
+    }
+    TEST("powersort with small buffers", powersort_ok);
+    
+    // Every strategy under several budgets; the workspace past the budget
+    // is a canary that must stay untouched
+    size_t n = 8000;
+    const size_t budgets[] = {0, n / 64, n / 8, n / 2 - 1, n};
+    const char* inputs[] = {"random", "streams", "reversed", "12-bit", "22-bit", "few keys"};
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+        bool sorted_ok = true, canary_ok = true;
+        for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+            switch (k) {
+                case 0: fill_streams(large_data, large_ref, n, 1, 0); break;
+                case 1: fill_streams(large_data, large_ref, n, 12, 0); break;
+                case 2:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i) * 3;
+                    break;
+                case 3:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFF;
+                    break;
+                case 4:
+                    for (size_t i = 0; i < n; i++) {
+                        uint32_t r = ((uint32_t)rand() << 8) ^ (uint32_t)rand();
+                        large_data[i] = large_ref[i] = (int32_t)(r & 0x3FFFFF);
+                    }
+                    break;
+                default:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 5) * 1000003;
+                    break;
+            }
+            for (size_t i = budgets[b]; i < budgets[b] + 64; i++) large_aux[i] = 0x5A5A5A5A;
+            hydra_sort_workspace(large_data, n, budgets[b] ? large_aux : NULL,
+                                 budgets[b] * sizeof(int32_t), HYDRA_PROFILE_BALANCED);
+            if (!matches_reference(large_data, large_ref, n)) sorted_ok = false;
+            for (size_t i = budgets[b]; i < budgets[b] + 64; i++) {
+                if (large_aux[i] != 0x5A5A5A5A) canary_ok = false;
+            }
+        }
+        char name[56];
+        snprintf(name, sizeof(name), "workspace %zu of %zu sorts", budgets[b], n);
+        TEST(name, sorted_ok);
+        snprintf(name, sizeof(name), "workspace %zu of %zu stays in budget", budgets[b], n);
+        TEST(name, canary_ok);
+    }
+    
+    // Selection follows the budget
+    fill_streams(large_data, large_ref, n, 12, 0);
+    HydraFeatures f = hydra_analyze(large_data, n);
+    HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("streams keep powersort with n/8", hydra_strategy_fit(s, &f, n / 8, HYDRA_PROFILE_BALANCED).algorithm == ALG_POWERSORT);
+    TEST("streams take pdqsort without aux", hydra_strategy_fit(s, &f, 0, HYDRA_PROFILE_BALANCED).algorithm == ALG_PDQSORT);
+    for (size_t i = 0; i < n; i++) large_data[i] = rand() & 0xFFFF;
+    f = hydra_analyze(large_data, n);
+    s = hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED);
+    TEST("radix goes in place below n", hydra_strategy_fit(s, &f, n - 1, HYDRA_PROFILE_BALANCED).algorithm == ALG_RADIX_INPLACE);
+}
+
 void test_main_entry() {
     printf("\n── Main Entry (hydra_sort) ───────────────────\n");
     
@@ -204,6 +744,959 @@ void test_main_entry() {
     TEST("hydra_sort n=500 low_power", is_sorted_i32(test_data, 500));
 }
 
+void test_cascade_merge() {
+    printf("\n── Cascade Merge ─────────────────────────────\n");
+    
+    // Four-way merge of back-to-back runs must not touch its neighbours
+    int32_t runs[10] = {1, 5, 9,  2, 6,  INT32_MAX,  0, 3, 4, 8};
+    int32_t merged[10];
+    hydra_merge4(runs, 3, runs + 3, 2, runs + 5, 1, runs + 6, 4, merged);
+    TEST("merge4 adjacent runs", is_sorted_i32(merged, 10) &&
+         runs[3] == 2 && runs[5] == INT32_MAX && runs[6] == 0);
+    
+    // Rank split reproduces the whole merge, including across ties
+    for (int i = 0; i < 400; i++) test_data[i] = rand() % 20;
+    for (int r = 0; r < 4; r++) hydra_introsort(test_data + r * 100, 100);
+    const int32_t* parts[4] = {test_data, test_data + 100, test_data + 200, test_data + 300};
+    const size_t lens[4] = {100, 100, 100, 100};
+    bool split_ok = true;
+    for (size_t rank = 0; rank <= 400; rank += 37) {
+        size_t pos[4];
+        hydra_merge4_split(parts, lens, rank, pos);
+        int32_t left_max = INT32_MIN, right_min = INT32_MAX;
+        for (int r = 0; r < 4; r++) {
+            if (pos[r] > 0 && parts[r][pos[r] - 1] > left_max) left_max = parts[r][pos[r] - 1];
+            if (pos[r] < 100 && parts[r][pos[r]] < right_min) right_min = parts[r][pos[r]];
+        }
+        if (pos[0] + pos[1] + pos[2] + pos[3] != rank || left_max > right_min) split_ok = false;
+    }
+    TEST("merge4 split by rank", split_ok);
+    
+    // Single-core cascade with a short final run
+    size_t n = 1000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    for (size_t i = 0; i < n; i += 48) hydra_introsort(large_data + i, (n - i < 48) ? n - i : 48);
+    hydra_cascade_merge(large_data, large_aux, n, 48);
+    TEST("cascade merge n=1000 run=48", matches_reference(large_data, large_ref, n));
+    
+    // Parallel path through hydra_sort: one level, then several
+    static const size_t sizes[] = {
+        HYDRA_BLOCK_SIZE + 1,
+        HYDRA_BLOCK_SIZE * 5 + 77,
+#if HYDRA_PLATFORM_HOST
+        HYDRA_BLOCK_SIZE * 16,
+        HYDRA_BLOCK_SIZE * 70 + 77,
+#endif
+    };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        n = sizes[s];
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_ULTRA_FAST);
+        char name[48];
+        snprintf(name, sizeof(name), "hydra_sort parallel n=%u", (unsigned)n);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    // Same path at every worker count the backend can offer
+    n = HYDRA_BLOCK_SIZE * 5 + 77;
+    for (unsigned w = 1; w <= 4; w++) {
+        hydra_set_workers(w);
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_ULTRA_FAST);
+        char name[48];
+        snprintf(name, sizeof(name), "hydra_sort parallel workers=%u", w);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    hydra_set_workers(0);
+    
+    // Persistent workers serve back-to-back sorts without relaunching
+    hydra_set_workers(4);
+    hydra_init();
+    bool persistent_ok = true;
+    for (int round = 0; round < 8; round++) {
+        n = HYDRA_BLOCK_SIZE * (1 + round % 4) + round;
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_ULTRA_FAST);
+        if (!matches_reference(large_data, large_ref, n)) persistent_ok = false;
+    }
+    hydra_deinit();
+    hydra_set_workers(0);
+    TEST("hydra_init persistent workers x8", persistent_ok);
+    
+    // Skewed blocks: an all-equal block (heapsort fallback) next to random ones,
+    // plus fewer blocks than workers so subranges have to be shared
+    static HydraParallelStats stats;
+    hydra_set_parallel_stats(&stats);
+    hydra_set_workers(4);
+    n = HYDRA_BLOCK_SIZE * 2 + HYDRA_BLOCK_SIZE / 2;
+    for (size_t i = 0; i < n; i++) {
+        large_data[i] = large_ref[i] = (i < HYDRA_BLOCK_SIZE) ? 42 : rand() - RAND_MAX / 2;
+    }
+    // (called directly: hydra_sort would pick pdqsort for this many duplicates)
+    hydra_parallel_sort(large_data, large_aux, n, HYDRA_BLOCK_SIZE);
+    uint64_t busy = 0;
+    for (unsigned w = 0; w < stats.workers; w++) busy += stats.busy_us[w];
+    TEST("parallel sort skewed blocks", matches_reference(large_data, large_ref, n));
+    TEST("parallel stats recorded", stats.workers == 4 && busy <= stats.wall_us * stats.workers + stats.workers);
+    hydra_set_workers(0);
+    hydra_set_parallel_stats(NULL);
+    
+    // Heavy duplicates spread over many blocks (ties across every split)
+    n = HYDRA_BLOCK_SIZE * 5 + 77;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 3) * 1000003;
+    large_data[7] = large_ref[7] = INT32_MAX;
+    large_data[n - 1] = large_ref[n - 1] = INT32_MIN;
+    hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort parallel duplicates", matches_reference(large_data, large_ref, n));
+}
+
+void test_sample_sort() {
+    printf("\n── Sample Sort ───────────────────────────────\n");
+    
+    size_t n = HYDRA_BLOCK_SIZE * 5 + 77;
+    for (unsigned w = 1; w <= 4; w++) {
+        hydra_set_workers(w);
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_parallel_sample_sort(large_data, large_aux, n, HYDRA_PROFILE_ULTRA_FAST);
+        char name[48];
+        snprintf(name, sizeof(name), "sample sort workers=%u", w);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    // One key makes up ~90% of the input: it must land in an equality bucket
+    hydra_set_workers(4);
+    for (size_t i = 0; i < n; i++) {
+        large_data[i] = large_ref[i] = (rand() % 10) ? 1234 : rand() - RAND_MAX / 2;
+    }
+    hydra_parallel_sample_sort(large_data, large_aux, n, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("sample sort skewed key", matches_reference(large_data, large_ref, n));
+    
+    // A handful of distinct values only
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 3) - 1;
+    hydra_parallel_sample_sort(large_data, large_aux, n, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("sample sort three values", matches_reference(large_data, large_ref, n));
+    
+    // Selected through hydra_sort
+    hydra_set_parallel_mode(HYDRA_PARALLEL_SAMPLE);
+    n = MAX_LARGE_SIZE;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("hydra_sort sample mode", matches_reference(large_data, large_ref, n));
+    hydra_set_parallel_mode(HYDRA_PARALLEL_MERGE);
+    hydra_set_workers(0);
+}
+
+void test_parallel_radix() {
+    printf("\n── Parallel Radix ────────────────────────────\n");
+    
+    // Ranges giving one, two and three digit passes, over uneven slices
+    static const int range_bits[] = {8, 20, 31};
+    size_t n = HYDRA_BLOCK_SIZE * 3 + 77;
+    for (unsigned w = 1; w <= 4; w++) {
+        hydra_set_workers(w);
+        for (size_t k = 0; k < sizeof(range_bits) / sizeof(range_bits[0]); k++) {
+            uint32_t mask = (range_bits[k] == 31) ? 0xFFFFFFFFu : (1u << range_bits[k]) - 1;
+            for (size_t i = 0; i < n; i++) {
+                uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+                large_data[i] = large_ref[i] = (int32_t)((r & mask) - mask / 2);
+            }
+            HydraFeatures f = hydra_analyze(large_data, n);
+            hydra_parallel_radix_sort(large_data, large_aux, n, f.min_val, f.range_log2);
+            char name[56];
+            snprintf(name, sizeof(name), "parallel radix workers=%u %d-bit", w, range_bits[k]);
+            TEST(name, matches_reference(large_data, large_ref, n));
+        }
+    }
+    
+    // Fewer elements than workers: empty slices count and scatter nothing
+    hydra_set_workers(4);
+    for (size_t i = 0; i < 3; i++) large_data[i] = large_ref[i] = 3 - (int32_t)i;
+    hydra_parallel_radix_sort(large_data, large_aux, 3, 1, 2);
+    TEST("parallel radix n < workers", matches_reference(large_data, large_ref, 3));
+    
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = 99;
+    hydra_parallel_radix_sort(large_data, large_aux, n, 99, 0);
+    TEST("parallel radix all equal", matches_reference(large_data, large_ref, n));
+    
+#if HYDRA_RADIX_WC
+    // Write-combining per worker: slices start off a cache line
+    hydra_set_radix_wc_threshold(0);
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    HydraFeatures f = hydra_analyze(large_data, n);
+    hydra_parallel_radix_sort(large_data, large_aux, n, f.min_val, f.range_log2);
+    TEST("parallel radix write-combining", matches_reference(large_data, large_ref, n));
+    hydra_set_radix_wc_threshold(HYDRA_RADIX_WC_THRESHOLD);
+#endif
+    
+    // uint16_t path
+    uint16_t* shorts = (uint16_t*)large_data;
+    uint16_t* shorts_aux = (uint16_t*)large_aux;
+    for (size_t i = 0; i < n; i++) shorts[i] = (uint16_t)rand();
+    hydra_parallel_counting_sort_u16(shorts, shorts_aux, n);
+    TEST("parallel counting u16", is_sorted_u16(shorts, n));
+    
+    // Selected through hydra_sort for large small-range input
+    n = MAX_LARGE_SIZE;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 100000 - 50000;
+    HydraFeatures big = hydra_analyze(large_data, n);
+    HydraStrategy s = hydra_select_strategy(&big, HYDRA_PROFILE_BALANCED);
+    TEST("selector picks parallel radix", s.algorithm == ALG_RADIX_256 && s.use_parallel);
+    hydra_sort(large_data, n, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("hydra_sort parallel radix path", matches_reference(large_data, large_ref, n));
+    hydra_set_workers(0);
+}
+
+#if HYDRA_BACKEND_PTHREAD
+typedef struct {
+    HydraContext* ctx;
+    int32_t* data;
+    int32_t* ref;
+    size_t n;
+    uint32_t mod;           // Key range, 0 = full
+    uint32_t seed;
+    bool ok;
+} ContextRun;
+
+// Sorts through its own context; rand() is not thread-safe, so xorshift
+static void* context_thread(void* arg) {
+    ContextRun* run = (ContextRun*)arg;
+    uint32_t x = run->seed;
+    run->ok = true;
+    for (int round = 0; round < 6; round++) {
+        for (size_t i = 0; i < run->n; i++) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            run->data[i] = run->ref[i] = (int32_t)(run->mod ? x % run->mod : x);
+        }
+        hydra_context_sort(run->ctx, run->data, run->n, HYDRA_PROFILE_ULTRA_FAST);
+        if (!matches_reference(run->data, run->ref, run->n)) run->ok = false;
+    }
+    return NULL;
+}
+#endif
+
+void test_context() {
+    printf("\n── Sorting Context ───────────────────────────\n");
+    
+    // Static: the per-context tables do not fit a core stack
+    static HydraContext ctx;
+    static HydraParallelStats stats;
+    
+    // Full aux, persistent workers, per-context stats
+    hydra_context_init(&ctx, large_aux, MAX_LARGE_SIZE);
+    hydra_context_set_workers(&ctx, 4);
+    hydra_context_set_parallel_stats(&ctx, &stats);
+    hydra_context_start(&ctx);
+    bool ok = true;
+    for (int round = 0; round < 4; round++) {
+        size_t n = MAX_LARGE_SIZE - (size_t)round * 1000;
+        for (size_t i = 0; i < n; i++) {
+            large_data[i] = large_ref[i] = (round & 1) ? rand() % 100000 : rand() - RAND_MAX / 2;
+        }
+        hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_ULTRA_FAST);
+        if (!matches_reference(large_data, large_ref, n)) ok = false;
+    }
+    TEST("context persistent workers x4", ok);
+    TEST("context parallel stats", stats.workers == hydra_workers_count(&ctx.workers) && stats.workers > 0);
+    hydra_context_stop(&ctx);
+    
+    // Sample mode through the context only
+    hydra_context_set_parallel_mode(&ctx, HYDRA_PARALLEL_SAMPLE);
+    hydra_context_set_parallel_stats(&ctx, NULL);
+    size_t n = MAX_LARGE_SIZE;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+    hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_ULTRA_FAST);
+    TEST("context sample mode", matches_reference(large_data, large_ref, n));
+    
+    // No aux: in-place algorithms only
+    hydra_context_init(&ctx, NULL, 0);
+    static const uint32_t mods[] = {0, 50, 4096, 1u << 20};
+    for (size_t m = 0; m < sizeof(mods) / sizeof(mods[0]); m++) {
+        n = 20000;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t r = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            large_data[i] = large_ref[i] = (int32_t)(mods[m] ? r % mods[m] : r);
+        }
+        hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_BALANCED);
+        char name[48];
+        snprintf(name, sizeof(name), "context no aux mod=%u", (unsigned)mods[m]);
+        TEST(name, matches_reference(large_data, large_ref, n));
+    }
+    
+    // Declared range: 12-bit ADC frames skip the analysis pass
+    hydra_context_init(&ctx, large_aux, MAX_LARGE_SIZE);
+    hydra_context_set_range(&ctx, 0, 4095);
+    ok = true;
+    for (int frame = 0; frame < 4; frame++) {
+        n = 5000 + (size_t)frame * 3;
+        for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFF;
+        hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_LOW_POWER);
+        if (!matches_reference(large_data, large_ref, n)) ok = false;
+    }
+    TEST("context declared range frames", ok);
+    
+    // A declared range wider than the keys; then too wide for counting/radix
+    hydra_context_set_range(&ctx, -1000000, 1000000);
+    n = 3000;
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 2001 - 1000;
+    hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_BALANCED);
+    TEST("context declared wide range", matches_reference(large_data, large_ref, n));
+    hydra_context_set_range(&ctx, INT32_MIN, INT32_MAX);
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)i;
+    hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_BALANCED);
+    TEST("context full range falls back to analysis", matches_reference(large_data, large_ref, n));
+    
+    // Per-context tuning leaves the global settings alone
+    hydra_context_set_range(&ctx, 1, 0);
+    hydra_context_set_counting_budget(&ctx, 0);
+    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() % 500;
+    HydraFeatures f = hydra_analyze(large_data, n);
+    hydra_context_sort(&ctx, large_data, n, HYDRA_PROFILE_BALANCED);
+    TEST("context counting budget 0", matches_reference(large_data, large_ref, n) && !ctx.range_known);
+    TEST("global budget unchanged",
+         hydra_select_strategy(&f, HYDRA_PROFILE_BALANCED).algorithm == ALG_COUNTING_I32);
+    
+#if HYDRA_BACKEND_PTHREAD
+    // Two contexts sorting at once from two threads, each with its own workers
+    static HydraContext ctx_b;
+    size_t half = MAX_LARGE_SIZE / 2;
+    hydra_context_init(&ctx, large_aux, half);
+    hydra_context_init(&ctx_b, large_aux + half, half);
+    hydra_context_set_workers(&ctx, 2);
+    hydra_context_set_workers(&ctx_b, 3);
+    hydra_context_set_parallel_mode(&ctx_b, HYDRA_PARALLEL_SAMPLE);
+    hydra_context_start(&ctx);
+    ContextRun runs[2] = {
+        {&ctx, large_data, large_ref, half, 0, 0x12345u, false},
+        {&ctx_b, large_data + half, large_ref + half, half, 100000, 0xBEEFu, false},
+    };
+    pthread_t threads[2];
+    for (int t = 0; t < 2; t++) pthread_create(&threads[t], NULL, context_thread, &runs[t]);
+    for (int t = 0; t < 2; t++) pthread_join(threads[t], NULL);
+    hydra_context_stop(&ctx);
+    TEST("two contexts in parallel threads", runs[0].ok && runs[1].ok);
+#endif
+}
+
+// Sort every slice's reference copy (same offsets in large_ref) and compare
+static bool batch_matches(const HydraSlice* slices, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        size_t off = (size_t)(slices[i].arr - large_data);
+        if (!matches_reference(slices[i].arr, large_ref + off, slices[i].n)) return false;
+    }
+    return true;
+}
+
+void test_batch() {
+    printf("\n── Batched Small Arrays ──────────────────────\n");
+    
+    static HydraSlice slices[HYDRA_BATCH_PARALLEL];
+    
+    // Every length from 0 to past the networks, in a scrambled order
+    size_t count = 0, off = 0;
+    for (size_t i = 0; i < 300; i++) {
+        size_t n = (i * 37) % 71;
+        slices[count].arr = large_data + off;
+        slices[count].n = n;
+        for (size_t j = 0; j < n; j++) large_data[off + j] = large_ref[off + j] = rand() - RAND_MAX / 2;
+        off += n;
+        count++;
+    }
+    hydra_sort_batch(slices, count);
+    TEST("batch lengths 0..70", batch_matches(slices, count));
+    
+    // Extremes next to the INT32_MAX padding, partial lane groups
+    off = 0;
+    for (count = 0; count < 11; count++) {
+        size_t n = 5 + count % 3;
+        slices[count].arr = large_data + off;
+        slices[count].n = n;
+        for (size_t j = 0; j < n; j++) {
+            int32_t v = (rand() & 1) ? INT32_MAX : (rand() & 1) ? INT32_MIN : rand();
+            large_data[off + j] = large_ref[off + j] = v;
+        }
+        off += n;
+    }
+    hydra_sort_batch(slices, count);
+    TEST("batch int32 extremes", batch_matches(slices, count));
+    
+    // Enough arrays to go parallel
+    hydra_set_workers(4);
+    off = 0;
+    for (count = 0; count < HYDRA_BATCH_PARALLEL; count++) {
+        size_t n = 2 + count % 4;
+        slices[count].arr = large_data + off;
+        slices[count].n = n;
+        for (size_t j = 0; j < n; j++) large_data[off + j] = large_ref[off + j] = rand() % 1000;
+        off += n;
+    }
+    hydra_sort_batch(slices, count);
+    TEST("batch parallel workers=4", batch_matches(slices, count));
+    hydra_set_workers(0);
+    
+    // Fixed stride with a gap after each array that must stay untouched
+    size_t n = 12, stride = 13;
+    count = 1000;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < n; j++) large_data[i * stride + j] = large_ref[i * stride + j] = rand();
+        large_data[i * stride + n] = 777;
+    }
+    hydra_sort_batch_strided(large_data, n, stride, count);
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        if (!matches_reference(large_data + i * stride, large_ref + i * stride, n)) ok = false;
+        if (large_data[i * stride + n] != 777) ok = false;
+    }
+    TEST("batch strided n=12 stride=13", ok);
+    
+    for (size_t len = 4; len <= 64; len *= 2) {
+        count = 300;
+        for (size_t i = 0; i < count * len; i++) large_data[i] = large_ref[i] = rand() - RAND_MAX / 2;
+        hydra_sort_batch_strided(large_data, len, len, count);
+        ok = true;
+        for (size_t i = 0; i < count; i++) {
+            if (!matches_reference(large_data + i * len, large_ref + i * len, len)) ok = false;
+        }
+        char name[48];
+        snprintf(name, sizeof(name), "batch strided n=%u", (unsigned)len);
+        TEST(name, ok);
+    }
+}
+
+// Fill a CSR layout starting at offset first; returns the segment count
+static size_t fill_segments(size_t* offsets, size_t first, size_t total, size_t huge) {
+    size_t segments = 0, off = first;
+    offsets[0] = off;
+    while (off < first + total) {
+        size_t n;
+        switch (rand() % 8) {
+            case 0: n = 100 + (size_t)rand() % 3000; break;   // Medium
+            case 1: n = huge; huge = 0; break;                // One huge row
+            default: n = (size_t)rand() % 20; break;          // Tiny
+        }
+        if (off + n > first + total) n = first + total - off;
+        for (size_t j = 0; j < n; j++) large_data[off + j] = large_ref[off + j] = rand() - RAND_MAX / 2;
+        off += n;
+        offsets[++segments] = off;
+    }
+    return segments;
+}
+
+static bool segments_match(const size_t* offsets, size_t segments) {
+    for (size_t i = 0; i < segments; i++) {
+        size_t n = offsets[i + 1] - offsets[i];
+        if (!matches_reference(large_data + offsets[i], large_ref + offsets[i], n)) return false;
+    }
+    return true;
+}
+
+void test_segments() {
+    printf("\n── Segmented Sort ────────────────────────────\n");
+    
+    static size_t offsets[MAX_LARGE_SIZE / 4];
+    size_t total = MAX_LARGE_SIZE - 100;
+    
+    // Skewed rows: tiny, medium and one holding about half the elements
+    hydra_set_workers(4);
+    size_t segments = fill_segments(offsets, 0, total, total / 2);
+    hydra_sort_segments(large_data, offsets, segments, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("segments skewed with aux", segments_match(offsets, segments));
+    
+    segments = fill_segments(offsets, 0, total, total / 2);
+    hydra_sort_segments(large_data, offsets, segments, NULL, HYDRA_PROFILE_BALANCED);
+    TEST("segments skewed in place", segments_match(offsets, segments));
+    
+    // Offsets need not start at 0; the values before the first stay put
+    for (size_t i = 0; i < 100; i++) large_data[i] = 100 - (int32_t)i;
+    segments = fill_segments(offsets, 100, total, 0);
+    hydra_sort_segments(large_data, offsets, segments, large_aux, HYDRA_PROFILE_BALANCED);
+    bool prefix_ok = true;
+    for (size_t i = 0; i < 100; i++) prefix_ok &= large_data[i] == 100 - (int32_t)i;
+    TEST("segments from a nonzero offset", segments_match(offsets, segments) && prefix_ok);
+    hydra_set_workers(0);
+    
+    // Small total: no workers at all
+    segments = fill_segments(offsets, 0, 3000, 0);
+    hydra_sort_segments(large_data, offsets, segments, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("segments small total", segments_match(offsets, segments));
+    
+    // Degenerate: one segment, and segments that are all empty
+    offsets[0] = 0;
+    offsets[1] = 5000;
+    for (size_t i = 0; i < 5000; i++) large_data[i] = large_ref[i] = rand() % 100;
+    hydra_sort_segments(large_data, offsets, 1, large_aux, HYDRA_PROFILE_BALANCED);
+    TEST("segments single", segments_match(offsets, 1));
+    for (size_t i = 0; i <= 50; i++) offsets[i] = 7;
+    hydra_sort_segments(large_data, offsets, 50, NULL, HYDRA_PROFILE_BALANCED);
+    TEST("segments all empty", true);
+}
+
+// Key for record/index i: deterministic, so payloads can be checked
+static int32_t kv_key(uint32_t i, uint32_t range) {
+    uint32_t h = i * 2654435761u;
+    h ^= h >> 15;
+    return (int32_t)(h % range - range / 2);
+}
+
+// keys[i] must belong to index vals[i], ascending, equal keys in index order
+static bool kv_stable(const int32_t* keys, const uint32_t* vals, size_t n, uint32_t range) {
+    for (size_t i = 0; i < n; i++) {
+        if (keys[i] != kv_key(vals[i], range)) return false;
+        if (i > 0 && (keys[i] < keys[i-1] || (keys[i] == keys[i-1] && vals[i] < vals[i-1]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_kv() {
+    printf("\n── Key-Value & Records ───────────────────────\n");
+    
+    // Values ride in large_ref, aux (2n words) in large_aux
+    int32_t* keys = large_data;
+    uint32_t* vals = (uint32_t*)large_ref;
+    uint32_t* aux = (uint32_t*)large_aux;
+    static const uint32_t ranges[] = {16, 1000, 1u << 20, 0xFFFFFFF0u};
+    static const size_t sizes[] = {0, 1, 15, 100, 1000, MAX_LARGE_SIZE / 2};
+    
+    for (size_t r = 0; r < 4; r++) {
+        bool radix_ok = true, inplace_ok = true, sorted_ok = true;
+        for (size_t s = 0; s < 6; s++) {
+            size_t n = sizes[s];
+            for (size_t i = 0; i < n; i++) { keys[i] = kv_key((uint32_t)i, ranges[r]); vals[i] = (uint32_t)i; }
+            hydra_sort_kv(keys, vals, n, aux);
+            radix_ok &= kv_stable(keys, vals, n, ranges[r]);
+            
+            for (size_t i = 0; i < n; i++) { keys[i] = kv_key((uint32_t)i, ranges[r]); vals[i] = (uint32_t)i; }
+            hydra_sort_kv(keys, vals, n, NULL);
+            inplace_ok &= kv_stable(keys, vals, n, ranges[r]);
+            
+            // Sorted except for a few swaps of unequal keys: the merge path
+            for (size_t i = 0; i + 1 < n; i += 97) {
+                if (keys[i] == keys[i + 1]) continue;
+                uint32_t t = vals[i]; vals[i] = vals[i + 1]; vals[i + 1] = t;
+                int32_t k = keys[i]; keys[i] = keys[i + 1]; keys[i + 1] = k;
+            }
+            hydra_sort_kv(keys, vals, n, aux);
+            sorted_ok &= kv_stable(keys, vals, n, ranges[r]);
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "kv radix, range %u", (unsigned)ranges[r]);
+        TEST(name, radix_ok);
+        snprintf(name, sizeof(name), "kv in place, range %u", (unsigned)ranges[r]);
+        TEST(name, inplace_ok);
+        snprintf(name, sizeof(name), "kv nearly sorted, range %u", (unsigned)ranges[r]);
+        TEST(name, sorted_ok);
+    }
+    
+    // Records: index at offset 0, key at key_offset, filler derived from the index
+    static const size_t record_sizes[] = {8, 12, 16, 40, 72};
+    static const size_t key_offsets[] = {4, 5, 8, 18, 60};
+    for (size_t r = 0; r < 5; r++) {
+        size_t size = record_sizes[r], key_offset = key_offsets[r];
+        size_t n = (MAX_LARGE_SIZE * sizeof(int32_t)) / size / 2;
+        uint8_t* recs = (uint8_t*)large_data;
+        for (size_t i = 0; i < n; i++) {
+            uint8_t* rec = recs + i * size;
+            for (size_t b = 0; b < size; b++) rec[b] = (uint8_t)(i * 7 + b);
+            uint32_t index = (uint32_t)i;
+            int32_t key = kv_key(index, 500);
+            memcpy(rec, &index, 4);
+            memcpy(rec + key_offset, &key, 4);
+        }
+        size_t need = hydra_records_workspace(n, size);
+        bool fits = need <= sizeof(large_aux);
+        if (fits) hydra_sort_records(recs, n, size, key_offset, large_aux);
+        
+        bool ok = fits;
+        uint32_t prev_index = 0;
+        int32_t prev_key = INT32_MIN;
+        for (size_t i = 0; ok && i < n; i++) {
+            uint8_t* rec = recs + i * size;
+            uint32_t index;
+            int32_t key;
+            memcpy(&index, rec, 4);
+            memcpy(&key, rec + key_offset, 4);
+            ok = key == kv_key(index, 500) && (key > prev_key || (key == prev_key && index > prev_index));
+            for (size_t b = 4; ok && b < size; b++) {
+                if (b < key_offset || b >= key_offset + 4) ok = rec[b] == (uint8_t)(index * 7 + b);
+            }
+            prev_index = index;
+            prev_key = key;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "records %u bytes (%s)", (unsigned)size,
+                 size <= HYDRA_RECORD_TAG_BYTES ? "direct" : "tag sort");
+        TEST(name, ok);
+    }
+}
+
+// idx must be a permutation that orders keys stably
+static bool argsort_valid(const int32_t* keys, const uint32_t* idx, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int32_t a = keys[idx[i - 1]], b = keys[idx[i]];
+        if (b < a || (a == b && idx[i] < idx[i - 1])) return false;
+    }
+    // Distinct and in range: sum and xor match 0..n-1 (idx is sorted by key, not value)
+    uint64_t sum = 0, want = 0;
+    uint32_t x = 0, want_x = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (idx[i] >= n) return false;
+        sum += idx[i]; want += i;
+        x ^= idx[i]; want_x ^= (uint32_t)i;
+    }
+    return sum == want && x == want_x;
+}
+
+void test_argsort() {
+    printf("\n── Argsort & Permutations ────────────────────\n");
+    
+    // Keys in large_data (left untouched), indices in large_ref, aux (3n) in large_aux
+    size_t n = MAX_LARGE_SIZE / 3;
+    int32_t* keys = large_data;
+    uint32_t* idx = (uint32_t*)large_ref;
+    uint32_t* aux = (uint32_t*)large_aux;
+    
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = pattern == 0 ? rand() - RAND_MAX / 2 :
+                      pattern == 1 ? rand() % 50 : (int32_t)i - (rand() % 8 == 0);
+        }
+        keys[n] = 12345;
+        
+        hydra_set_workers(4);
+        hydra_argsort(keys, idx, n, aux);
+        bool ok = argsort_valid(keys, idx, n);
+        hydra_set_workers(0);
+        hydra_argsort(keys, idx, n, NULL);
+        bool ok_inplace = argsort_valid(keys, idx, n) && keys[n] == 12345;
+        
+        static const char* names[] = {"random", "50 keys", "nearly sorted"};
+        char name[64];
+        snprintf(name, sizeof(name), "argsort %s", names[pattern]);
+        TEST(name, ok);
+        snprintf(name, sizeof(name), "argsort %s, no aux", names[pattern]);
+        TEST(name, ok_inplace);
+    }
+    
+    // Apply to three columns: the key itself, a byte and a 12-byte record
+    typedef struct { int32_t a, b, c; } Triple;
+    n = 1000;
+    static uint8_t bytes[1000];
+    static Triple triples[1000];
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = rand() % 300;
+        bytes[i] = (uint8_t)keys[i];
+        triples[i].a = keys[i]; triples[i].b = (int32_t)i; triples[i].c = -keys[i];
+    }
+    hydra_argsort(keys, idx, n, aux);
+    memcpy(test_data, idx, n * sizeof(uint32_t));
+    
+    void* columns[3] = {keys, bytes, triples};
+    size_t sizes[3] = {sizeof(int32_t), sizeof(uint8_t), sizeof(Triple)};
+    hydra_apply_permutation(idx, n, columns, sizes, 3, NULL);
+    
+    bool ok = memcmp(test_data, idx, n * sizeof(uint32_t)) == 0;   // perm restored
+    for (size_t i = 0; i < n; i++) {
+        ok = ok && (i == 0 || keys[i - 1] <= keys[i]) && bytes[i] == (uint8_t)keys[i] &&
+             triples[i].a == keys[i] && triples[i].c == -keys[i] && triples[i].b == (int32_t)idx[i];
+    }
+    TEST("apply permutation to 3 columns", ok);
+    
+    // Reverse everything through scratch
+    for (size_t i = 0; i < n; i++) idx[i] = (uint32_t)(n - 1 - i);
+    hydra_apply_permutation(idx, n, columns, sizes, 3, aux);
+    ok = true;
+    for (size_t i = 0; i < n; i++) {
+        ok = ok && (i == 0 || keys[i - 1] >= keys[i]) && bytes[i] == (uint8_t)keys[i] &&
+             triples[i].a == keys[i] && triples[i].c == -keys[i];
+    }
+    TEST("apply permutation through scratch", ok);
+    
+    // Identity and a single n-cycle
+    for (size_t i = 0; i < n; i++) { idx[i] = (uint32_t)i; keys[i] = (int32_t)i; }
+    void* one[1] = {keys};
+    hydra_apply_permutation(idx, n, one, sizes, 1, NULL);
+    ok = true;
+    for (size_t i = 0; i < n; i++) ok = ok && keys[i] == (int32_t)i;
+    for (size_t i = 0; i < n; i++) idx[i] = (uint32_t)((i + 1) % n);
+    hydra_apply_permutation(idx, n, one, sizes, 1, NULL);
+    for (size_t i = 0; i < n; i++) ok = ok && keys[i] == (int32_t)((i + 1) % n);
+    TEST("apply identity and one long cycle", ok);
+}
+
+static bool is_stable_algorithm(HydraAlgorithm a) {
+    return a == ALG_INSERTION || a == ALG_POWERSORT || a == ALG_COUNTING_I32 || a == ALG_RADIX_256;
+}
+
+void test_stable_profile() {
+    printf("\n── Stable Profile ────────────────────────────\n");
+    
+    // Every input under every budget: sorted, and only stable engines chosen
+    size_t n = 8000;
+    const size_t budgets[] = {0, n / 64, n / 2, n};
+    const char* inputs[] = {"random", "streams", "nearly sorted", "reversed", "12-bit", "few keys"};
+    for (size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++) {
+        bool sorted_ok = true, engines_ok = true;
+        for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+            switch (k) {
+                case 0: fill_streams(large_data, large_ref, n, 1, 0); break;
+                case 1: fill_streams(large_data, large_ref, n, 12, 0); break;
+                case 2:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)i + rand() % 8;
+                    break;
+                case 3:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (int32_t)(n - i) * 3;
+                    break;
+                case 4:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = rand() & 0xFFF;
+                    break;
+                default:
+                    for (size_t i = 0; i < n; i++) large_data[i] = large_ref[i] = (rand() % 5) * 1000003;
+                    break;
+            }
+            HydraFeatures f = hydra_analyze(large_data, n);
+            HydraStrategy s = hydra_select_strategy(&f, HYDRA_PROFILE_STABLE);
+            s = hydra_strategy_fit(s, &f, budgets[b], HYDRA_PROFILE_STABLE);
+            engines_ok &= is_stable_algorithm(s.algorithm) && !s.use_partitioning;
+            
+            hydra_sort_workspace(large_data, n, budgets[b] ? large_aux : NULL,
+                                 budgets[b] * sizeof(int32_t), HYDRA_PROFILE_STABLE);
+            sorted_ok &= matches_reference(large_data, large_ref, n);
+        }
+        char name[56];
+        snprintf(name, sizeof(name), "stable sorts %s", inputs[k]);
+        TEST(name, sorted_ok);
+        snprintf(name, sizeof(name), "stable engines only, %s", inputs[k]);
+        TEST(name, engines_ok);
+    }
+    
+    // Short arrays skip the networks; the large path may go parallel
+    bool ok = true;
+    for (size_t len = 2; len <= 64; len++) {
+        for (size_t i = 0; i < len; i++) test_data[i] = rand() % 7;
+        hydra_sort(test_data, len, NULL, HYDRA_PROFILE_STABLE);
+        ok &= is_sorted_i32(test_data, len);
+    }
+    TEST("stable short arrays", ok);
+    fill_streams(large_data, large_ref, MAX_LARGE_SIZE, 1, 0);
+    hydra_sort(large_data, MAX_LARGE_SIZE, large_aux, HYDRA_PROFILE_STABLE);
+    TEST("stable large (radix)", matches_reference(large_data, large_ref, MAX_LARGE_SIZE));
+    
+    // Pairs in a few sorted runs with duplicate keys: the merge path keeps order
+    int32_t* keys = large_data;
+    uint32_t* vals = (uint32_t*)large_ref;
+    size_t m = MAX_LARGE_SIZE / 2;
+    for (size_t i = 0; i < m; i++) { keys[i] = kv_key((uint32_t)i, 300); vals[i] = (uint32_t)i; }
+    for (size_t i = 0; i < m; i += m / 6 + 1) {
+        hydra_sort_kv(keys + i, vals + i, (m - i < m / 6 + 1) ? m - i : m / 6 + 1, NULL);
+    }
+    hydra_sort_kv(keys, vals, m, (uint32_t*)large_aux);
+    TEST("kv runs stay stable", kv_stable(keys, vals, m, 300));
+}
+
+// arr holds ref's values and is partitioned around rank k (ref sorted)
+static bool selected_at(const int32_t* arr, const int32_t* ref, size_t n, size_t k) {
+    if (arr[k] != ref[k]) return false;
+    for (size_t i = 0; i < k; i++) if (arr[i] > arr[k]) return false;
+    for (size_t i = k + 1; i < n; i++) if (arr[i] < arr[k]) return false;
+    return true;
+}
+
+// Same multiset as sorted ref (sorts arr)
+static bool same_values(int32_t* arr, const int32_t* ref, size_t n) {
+    hydra_introsort(arr, n);
+    return memcmp(arr, ref, n * sizeof(int32_t)) == 0;
+}
+
+static void fill_select(int32_t* a, size_t n, int pattern) {
+    for (size_t i = 0; i < n; i++) {
+        switch (pattern) {
+            case 0: a[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()); break;
+            case 1: a[i] = rand() % 7; break;
+            case 2: a[i] = (int32_t)i; break;
+            case 3: a[i] = (int32_t)(n - i); break;
+            case 4: a[i] = (int32_t)(i < n / 2 ? i : n - i); break;   // Organ pipe
+            case 5: a[i] = 42; break;
+            default: a[i] = (rand() % 1000) * 65536 + (rand() & 3); break;  // Clustered low bits
+        }
+    }
+}
+
+void test_select() {
+    printf("\n── Selection ─────────────────────────────────\n");
+    
+    static const char* patterns[] = {"random", "few keys", "sorted", "reversed",
+                                     "organ pipe", "all equal", "clustered"};
+    static const size_t sizes[] = {1, 2, 23, 24, 100, 5000, MAX_LARGE_SIZE};
+    
+    // With aux, large inputs narrow across the workers
+    hydra_set_workers(4);
+    for (int pattern = 0; pattern < 7; pattern++) {
+        bool nth_ok = true, aux_ok = true;
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            size_t n = sizes[s];
+            size_t ks[] = {0, n / 2, n - 1, n / 100, (size_t)rand() % n};
+            for (size_t j = 0; j < 5; j++) {
+                fill_select(large_data, n, pattern);
+                memcpy(large_ref, large_data, n * sizeof(int32_t));
+                hydra_introsort(large_ref, n);
+                
+                hydra_nth_element(large_data, n, ks[j], NULL);
+                nth_ok &= selected_at(large_data, large_ref, n, ks[j]) && same_values(large_data, large_ref, n);
+                
+                fill_select(large_data, n, pattern);
+                memcpy(large_ref, large_data, n * sizeof(int32_t));
+                hydra_introsort(large_ref, n);
+                hydra_nth_element(large_data, n, ks[j], large_aux);
+                aux_ok &= selected_at(large_data, large_ref, n, ks[j]) && same_values(large_data, large_ref, n);
+            }
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "nth_element %s", patterns[pattern]);
+        TEST(name, nth_ok);
+        snprintf(name, sizeof(name), "nth_element %s (aux)", patterns[pattern]);
+        TEST(name, aux_ok);
+    }
+    
+    // Median of medians for every pivot, on the inputs that defeat median of three
+    bool mom_ok = true;
+    for (int pattern = 0; pattern < 7; pattern++) {
+        size_t n = 5000;
+        fill_select(large_data, n, pattern);
+        memcpy(large_ref, large_data, n * sizeof(int32_t));
+        hydra_introsort(large_ref, n);
+        hydra_introselect(large_data, 0, n - 1, n / 3, 0, true);
+        mom_ok &= selected_at(large_data, large_ref, n, n / 3);
+    }
+    TEST("median of medians fallback", mom_ok);
+    
+    // Top-k, heap (small k) and select + sort (large k)
+    static const size_t top[] = {0, 1, 5, 100, 2000, MAX_LARGE_SIZE / 2, MAX_LARGE_SIZE};
+    bool top_ok = true;
+    for (size_t t = 0; t < sizeof(top) / sizeof(top[0]); t++) {
+        for (int pattern = 0; pattern < 7; pattern += 3) {
+            size_t n = MAX_LARGE_SIZE, k = top[t];
+            fill_select(large_data, n, pattern);
+            memcpy(large_ref, large_data, n * sizeof(int32_t));
+            hydra_introsort(large_ref, n);
+            hydra_partial_sort(large_data, n, k, (t & 1) ? large_aux : NULL);
+            top_ok &= memcmp(large_data, large_ref, k * sizeof(int32_t)) == 0 &&
+                      same_values(large_data, large_ref, n);
+        }
+    }
+    TEST("partial sort top-k", top_ok);
+    
+    // Several ranks in one call: percentiles, repeats, neighbours
+    size_t n = MAX_LARGE_SIZE;
+    size_t ranks[] = {0, n / 100, n / 2, n / 2, n / 2 + 1, n * 9 / 10, n * 99 / 100, n * 999 / 1000, n - 1};
+    size_t count = sizeof(ranks) / sizeof(ranks[0]);
+    bool many_ok = true;
+    for (int pattern = 0; pattern < 7; pattern++) {
+        fill_select(large_data, n, pattern);
+        memcpy(large_ref, large_data, n * sizeof(int32_t));
+        hydra_introsort(large_ref, n);
+        hydra_nth_elements(large_data, n, ranks, count, (pattern & 1) ? large_aux : NULL);
+        for (size_t r = 0; r < count; r++) many_ok &= selected_at(large_data, large_ref, n, ranks[r]);
+    }
+    TEST("nth_elements percentiles", many_ok);
+    hydra_set_workers(0);
+}
+
+// Quantiles of arr (read-only) against sorted ref
+static bool quantiles_match(const int32_t* arr, const int32_t* ref, size_t n,
+                            const size_t* ranks, size_t count) {
+    int32_t out[40] = {0};
+    memcpy(large_aux, arr, n * sizeof(int32_t));
+    hydra_quantiles(arr, n, ranks, count, out);
+    bool ok = memcmp(large_aux, arr, n * sizeof(int32_t)) == 0;
+    for (size_t r = 0; r < count; r++) ok &= out[r] == ref[ranks[r]];
+    return ok;
+}
+
+void test_quantiles() {
+    printf("\n── Quantiles ─────────────────────────────────\n");
+    
+    static const char* patterns[] = {"random", "few keys", "sorted", "reversed",
+                                     "organ pipe", "all equal", "clustered", "latency",
+                                     "three levels"};
+    static const size_t sizes[] = {1, 2, 23, 100, 5000, 7000, MAX_LARGE_SIZE};
+    
+    for (int pattern = 0; pattern < 9; pattern++) {
+        bool ok = true;
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            size_t n = sizes[s];
+            fill_select(large_data, n, pattern);
+            // Microsecond latencies: a dense body and a long tail
+            if (pattern == 7) {
+                for (size_t i = 0; i < n; i++) {
+                    large_data[i] = 200 + rand() % 800 + ((rand() % 100 == 0) ? rand() % 250000 : 0);
+                }
+            }
+            // Buckets too big to copy at the first two digits
+            if (pattern == 8) {
+                for (size_t i = 0; i < n; i++) {
+                    large_data[i] = (int32_t)((i % 3) << 24 | (size_t)(rand() % 2) << 12 | (size_t)(rand() % 1024)) - 20000000;
+                }
+            }
+            memcpy(large_ref, large_data, n * sizeof(int32_t));
+            hydra_introsort(large_ref, n);
+            size_t ranks[] = {0, n / 2, n - 1, (size_t)rand() % n, n / 2,
+                              hydra_quantile_rank(n, 500000), hydra_quantile_rank(n, 990000),
+                              hydra_quantile_rank(n, 999000)};
+            ok &= quantiles_match(large_data, large_ref, n, ranks, sizeof(ranks) / sizeof(ranks[0]));
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "quantiles %s", patterns[pattern]);
+        TEST(name, ok);
+    }
+    
+    // More ranks than one pass resolves, and extremes of the int32 range
+    size_t n = MAX_LARGE_SIZE;
+    size_t ranks[40];
+    for (size_t r = 0; r < 40; r++) ranks[r] = (size_t)rand() % n;
+    for (size_t i = 0; i < n; i++) {
+        large_data[i] = (i % 3 == 0) ? INT32_MIN + rand() % 4 : (i % 3 == 1) ? INT32_MAX - rand() % 4 : rand();
+    }
+    memcpy(large_ref, large_data, n * sizeof(int32_t));
+    hydra_introsort(large_ref, n);
+    TEST("quantiles 40 ranks, int32 extremes", quantiles_match(large_data, large_ref, n, ranks, 40));
+    
+    TEST("quantile rank nearest-rank",
+         hydra_quantile_rank(1000, 990000) == 989 && hydra_quantile_rank(1000, 999000) == 998 &&
+         hydra_quantile_rank(1001, 500000) == 500 && hydra_quantile_rank(7, 0) == 0 &&
+         hydra_quantile_rank(7, 1000000) == 6 && hydra_quantile_rank(1, 999000) == 0);
+    
+    // u8 and u16, with the reference widened to int32
+    uint8_t* bytes = (uint8_t*)large_data;
+    uint16_t* shorts = (uint16_t*)large_data;
+    uint8_t out8[40] = {0};
+    uint16_t out16[40] = {0};
+    bool u8_ok = true, u16_ok = true, u16_counts_ok = true;
+    for (int pattern = 0; pattern < 3; pattern++) {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t r = (uint32_t)rand();
+            large_ref[i] = pattern == 0 ? (int32_t)(r & 0xFFFF) : pattern == 1 ? (int32_t)(r % 3) : 60000 + (int32_t)(r % 5000);
+        }
+        for (size_t i = 0; i < n; i++) bytes[i] = (uint8_t)large_ref[i];
+        hydra_quantiles_u8(bytes, n, ranks, 40, out8);
+        for (size_t i = 0; i < n; i++) large_aux[i] = (uint8_t)large_ref[i];
+        hydra_introsort(large_aux, n);
+        for (size_t r = 0; r < 40; r++) u8_ok &= out8[r] == large_aux[ranks[r]];
+        
+        for (size_t i = 0; i < n; i++) shorts[i] = (uint16_t)large_ref[i];
+        hydra_introsort(large_ref, n);
+        hydra_quantiles_u16(shorts, n, ranks, 40, out16, NULL);
+        for (size_t r = 0; r < 40; r++) u16_ok &= out16[r] == large_ref[ranks[r]];
+#if MAX_LARGE_SIZE >= 65536
+        hydra_quantiles_u16(shorts, n, ranks, 40, out16, (uint32_t*)large_aux);
+        for (size_t r = 0; r < 40; r++) u16_counts_ok &= out16[r] == large_ref[ranks[r]];
+#endif
+    }
+    TEST("quantiles u8", u8_ok);
+    TEST("quantiles u16 (digit passes)", u16_ok);
+    TEST("quantiles u16 (full counts)", u16_counts_ok);
+}
+
 void test_edge_cases() {
     printf("\n── Edge Cases ────────────────────────────────\n");
     
@@ -242,8 +1735,10 @@ void test_edge_cases() {
 }
 
 int main() {
+#if HYDRA_PLATFORM_PICO
     stdio_init_all();
     sleep_ms(2000);
+#endif
     
     printf("\n");
     printf("╔═══════════════════════════════════════════════════════╗\n");
@@ -257,8 +1752,26 @@ int main() {
     test_shell_sort();
     test_counting_sort();
     test_radix_sort();
+    test_radix_i32();
+    test_american_flag();
     test_introsort();
+    test_partition_schemes();
+    test_dual_pivot();
+    test_pdqsort();
+    test_powersort();
+    test_memory_budget();
     test_main_entry();
+    test_cascade_merge();
+    test_sample_sort();
+    test_parallel_radix();
+    test_context();
+    test_batch();
+    test_segments();
+    test_kv();
+    test_argsort();
+    test_stable_profile();
+    test_select();
+    test_quantiles();
     test_edge_cases();
     
     printf("\n═══════════════════════════════════════════════════════\n");
@@ -271,9 +1784,11 @@ int main() {
         printf("✗ Some tests failed!\n");
     }
     
+#if HYDRA_PLATFORM_PICO
     while (1) {
         tight_loop_contents();
     }
+#endif
     
-    return 0;
+    return tests_failed == 0 ? 0 : 1;
 }
@@ -0,0 +1,226 @@
+/**
+ * HYDRA-SORT C++ Front End Tests
+ *
+ * Checks hydra::sort<T> against std::sort for every supported type,
+ * across the 1/2/4/8-byte paths, with and without aux.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "hydra_sort_v2.hpp"
+
+#if HYDRA_PLATFORM_PICO
+#define MAX_CPP_SIZE 4096
+#else
+#define MAX_CPP_SIZE 100000
+#endif
+
+static uint64_t cpp_data[MAX_CPP_SIZE];
+static uint64_t cpp_ref[MAX_CPP_SIZE];
+static uint64_t cpp_aux[MAX_CPP_SIZE];
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST(name, condition) do { \
+    if (condition) { \
+        printf("  [PASS] %s\n", name); \
+        tests_passed++; \
+    } else { \
+        printf("  [FAIL] %s\n", name); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t next_random() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+// Random bits, a narrow range, or (for floats) finite values of both signs
+template<typename T>
+static T random_value(int pattern) {
+    uint64_t r = next_random();
+    if constexpr (std::is_floating_point_v<T>) {
+        if (pattern == 1) return (T)((int)(r % 64) - 32);
+        return (T)((double)(int64_t)r / 1e6);
+    } else {
+        if (pattern == 1) return (T)(r % 64);
+        T x;
+        memcpy(&x, &r, sizeof(x));
+        return x;
+    }
+}
+
+// Sort n values of T with hydra::sort and std::sort and compare bit for bit
+template<typename T>
+static bool sorts_like_std(size_t n, int pattern, bool with_aux) {
+    T* data = reinterpret_cast<T*>(cpp_data);
+    T* ref = reinterpret_cast<T*>(cpp_ref);
+    T* aux = with_aux ? reinterpret_cast<T*>(cpp_aux) : nullptr;
+    for (size_t i = 0; i < n; i++) {
+        data[i] = random_value<T>(pattern);
+        if (pattern == 2) data[i] = (T)(data[i] / 2 + (T)i);  // Nearly ascending
+    }
+    memcpy(ref, data, n * sizeof(T));
+    hydra::sort(data, n, aux);
+    std::sort(ref, ref + n);
+    return memcmp(data, ref, n * sizeof(T)) == 0;
+}
+
+template<typename T>
+static void test_type(const char* name) {
+    static const size_t sizes[] = {0, 1, 4, 8, 13, 16, 100, 255, 256, 1024, 5000, MAX_CPP_SIZE};
+    char label[96];
+    for (int pattern = 0; pattern < 3; pattern++) {
+        bool ok = true;
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            ok = ok && sorts_like_std<T>(sizes[s], pattern, true);
+            ok = ok && sorts_like_std<T>(sizes[s], pattern, false);
+        }
+        static const char* patterns[] = {"random", "narrow", "nearly sorted"};
+        snprintf(label, sizeof(label), "%s: %s", name, patterns[pattern]);
+        TEST(label, ok);
+    }
+}
+
+static void test_float_order() {
+    printf("\n=== Float Total Order ===\n");
+
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    float inf = std::numeric_limits<float>::infinity();
+    float f[] = {nan, 1.5f, -0.0f, inf, -2.0f, 0.0f, -inf, -nan, 1e-40f, -1e-40f};
+    hydra::sort(f, sizeof(f) / sizeof(f[0]));
+    bool ok = std::isnan(f[0]) && std::signbit(f[0]) && f[1] == -inf && f[2] == -2.0f &&
+              f[3] == -1e-40f && f[4] == 0.0f && std::signbit(f[4]) &&
+              f[5] == 0.0f && !std::signbit(f[5]) && f[6] == 1e-40f && f[7] == 1.5f &&
+              f[8] == inf && std::isnan(f[9]) && !std::signbit(f[9]);
+    TEST("float: -NaN < -inf < -0 < +0 < +inf < +NaN", ok);
+
+    double d[2000];
+    for (size_t i = 0; i < 2000; i++) d[i] = (i % 3 == 0) ? -0.0 : (i % 3 == 1) ? 0.0 : -1.0;
+    double aux[2000];
+    hydra::sort(d, 2000, aux);
+    ok = true;
+    for (size_t i = 0; i < 2000; i++) {
+        double want = i < 666 ? -1.0 : 0.0;
+        bool neg = i < 1333;
+        ok = ok && d[i] == want && std::signbit(d[i]) == neg;
+    }
+    TEST("double radix: -0.0 before +0.0", ok);
+}
+
+static void test_timestamps() {
+    printf("\n=== 64-bit Timestamps ===\n");
+
+    // Microsecond timestamps over an hour: only the low bytes vary
+    uint64_t* data = cpp_data;
+    uint64_t* ref = cpp_ref;
+    uint64_t base = 1700000000000000ull;
+    for (size_t i = 0; i < MAX_CPP_SIZE; i++) data[i] = base + next_random() % 3600000000ull;
+    memcpy(ref, data, MAX_CPP_SIZE * sizeof(uint64_t));
+    hydra::sort(data, MAX_CPP_SIZE, cpp_aux);
+    std::sort(ref, ref + MAX_CPP_SIZE);
+    TEST("uint64 timestamps (radix)", memcmp(data, ref, MAX_CPP_SIZE * sizeof(uint64_t)) == 0);
+
+    // Descending, all equal: introsort's worst cases
+    for (size_t i = 0; i < MAX_CPP_SIZE; i++) data[i] = MAX_CPP_SIZE - i;
+    hydra::sort(data, MAX_CPP_SIZE);
+    bool ok = true;
+    for (size_t i = 0; i < MAX_CPP_SIZE; i++) ok = ok && data[i] == i + 1;
+    TEST("uint64 descending (introsort)", ok);
+
+    for (size_t i = 0; i < MAX_CPP_SIZE; i++) data[i] = 42;
+    hydra::sort(data, MAX_CPP_SIZE);
+    ok = true;
+    for (size_t i = 0; i < MAX_CPP_SIZE; i++) ok = ok && data[i] == 42;
+    TEST("uint64 all equal (introsort)", ok);
+}
+
+// hydra::argsort against std::stable_sort of indices by key
+template<typename T>
+static bool argsort_like_std(size_t n, bool with_aux) {
+    T* keys = reinterpret_cast<T*>(cpp_data);
+    uint32_t* idx = reinterpret_cast<uint32_t*>(cpp_ref);
+    uint32_t* ref = idx + n;
+    uint32_t* aux = with_aux ? reinterpret_cast<uint32_t*>(cpp_aux) : nullptr;
+    for (size_t i = 0; i < n; i++) keys[i] = random_value<T>((int)(i % 2));
+    hydra::argsort(keys, idx, n, aux);
+    for (size_t i = 0; i < n; i++) ref[i] = (uint32_t)i;
+    std::stable_sort(ref, ref + n, [keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    return memcmp(idx, ref, n * sizeof(uint32_t)) == 0;
+}
+
+template<typename T>
+static void test_argsort(const char* name) {
+    bool ok = true;
+    static const size_t sizes[] = {0, 1, 5, 16, 17, 1000, MAX_CPP_SIZE / 2};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ok = ok && argsort_like_std<T>(sizes[s], true) && argsort_like_std<T>(sizes[s], false);
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "argsort %s", name);
+    TEST(label, ok);
+}
+
+int main() {
+#if HYDRA_PLATFORM_PICO
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    printf("\n");
+    printf("╔═══════════════════════════════════════════════════════╗\n");
+    printf("║           HYDRA-SORT C++ FRONT END TESTS              ║\n");
+    printf("╚═══════════════════════════════════════════════════════╝\n");
+
+    printf("\n=== Integer Types ===\n");
+    test_type<int8_t>("int8");
+    test_type<uint8_t>("uint8");
+    test_type<int16_t>("int16");
+    test_type<uint16_t>("uint16");
+    test_type<int32_t>("int32");
+    test_type<uint32_t>("uint32");
+    test_type<int64_t>("int64");
+    test_type<uint64_t>("uint64");
+
+    printf("\n=== Floating Point ===\n");
+    test_type<float>("float");
+    test_type<double>("double");
+    test_float_order();
+    test_timestamps();
+
+    printf("\n=== Argsort ===\n");
+    test_argsort<int8_t>("int8");
+    test_argsort<uint16_t>("uint16");
+    test_argsort<int32_t>("int32");
+    test_argsort<uint32_t>("uint32");
+    test_argsort<float>("float");
+    test_argsort<int64_t>("int64");
+    test_argsort<double>("double");
+
+    printf("\n═══════════════════════════════════════════════════════\n");
+    printf("RESULTS: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("═══════════════════════════════════════════════════════\n\n");
+
+    if (tests_failed == 0) {
+        printf("✓ All tests passed!\n");
+    } else {
+        printf("✗ Some tests failed!\n");
+    }
+
+#if HYDRA_PLATFORM_PICO
+    while (1) {
+        tight_loop_contents();
+    }
+#endif
+
+    return tests_failed == 0 ? 0 : 1;
+}